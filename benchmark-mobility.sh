@@ -0,0 +1,48 @@
+#!/bin/bash
+
+# =============================================================================
+# Benchmark de Mobilidade FANET
+# Compara ArbitraryMobility (um timer por UAV) com SwarmMobility (um evento
+# por passo para o enxame) com 100/1000/5000 UAVs: eventos/s e tempo real
+# =============================================================================
+
+CONFIG=${1:-SwarmScale}
+
+echo "⏱️  Benchmark de mobilidade ($CONFIG)"
+
+# Compilar se necessário
+if [ ! -f "./fanet-simples" ]; then
+    echo "🔨 Compilando..."
+    make MODE=release > /dev/null 2>&1
+fi
+
+cd simulations
+
+RUNS=$(../fanet-simples -n /Users/rodrigo/omnetpp-workspace/inet-4.5.4/src:../src:. \
+    -l /Users/rodrigo/omnetpp-workspace/inet-4.5.4/src/libINET.dylib \
+    -c "$CONFIG" -q numruns omnetpp.ini 2>/dev/null | tail -1)
+
+printf "%-6s %-40s %14s %12s\n" "run" "parâmetros" "eventos/s" "tempo real"
+echo "─────────────────────────────────────────────────────────────────────────────"
+
+for ((run = 0; run < RUNS; run++)); do
+    PARAMS=$(../fanet-simples -n /Users/rodrigo/omnetpp-workspace/inet-4.5.4/src:../src:. \
+        -l /Users/rodrigo/omnetpp-workspace/inet-4.5.4/src/libINET.dylib \
+        -c "$CONFIG" -r $run -q itervars omnetpp.ini 2>/dev/null | tail -1)
+
+    START=$(date +%s.%N)
+    OUTPUT=$(../fanet-simples \
+        -l /Users/rodrigo/omnetpp-workspace/inet-4.5.4/src/libINET.dylib \
+        -n /Users/rodrigo/omnetpp-workspace/inet-4.5.4/src:../src:. \
+        -u Cmdenv -c "$CONFIG" -r $run omnetpp.ini 2>&1)
+    END=$(date +%s.%N)
+
+    # Última linha de desempenho do cmdenv: "... ev/sec=NNN ..."
+    EVPS=$(echo "$OUTPUT" | grep -o "ev/sec=[0-9.e+]*" | tail -1 | cut -d= -f2)
+    WALL=$(echo "$END - $START" | bc)
+
+    printf "%-6s %-40s %14s %11.2fs\n" "#$run" "$PARAMS" "${EVPS:-?}" "$WALL"
+done
+
+echo "─────────────────────────────────────────────────────────────────────────────"
+echo "✅ Resultados escalares (ex.: numSteps, kernelWallTime no SwarmScale) em simulations/results/"
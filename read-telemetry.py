@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+# Leitor dos registros binários de telemetria da GCS (<telemetryLog>-gcsN.tlm)
+# Uso: ./read-telemetry.py arquivo.tlm [...]          (resumo por UAV)
+#      ./read-telemetry.py --csv arquivo.tlm > dados.csv (todos os registros)
+
+import argparse
+import csv
+import struct
+import sys
+
+MAGIC = b"FANETTLM"
+HEADER = struct.Struct("<8sIIi12x")
+# Layout de TelemetryLogRecord (src/TelemetryLog.h), little-endian em qualquer host
+RECORD = struct.Struct("<6dfIHBBBBH")
+FIELDS = ("arrivalTime", "sampleTime", "delay", "positionX", "positionY", "positionZ",
+          "temperature", "sequence", "sourceNode", "hopCount", "attempt", "battery", "flags")
+DUPLICATE = 1
+
+
+def read_records(path):
+    with open(path, "rb") as f:
+        magic, version, record_size, gcs_node = HEADER.unpack(f.read(HEADER.size))
+        if magic != MAGIC:
+            sys.exit(f"{path}: não é um registro de telemetria FANET")
+        if version != 1 or record_size != RECORD.size:
+            sys.exit(f"{path}: versão {version} / registro de {record_size} bytes não suportados")
+        data = f.read()
+    usable = len(data) - len(data) % RECORD.size
+    for values in RECORD.iter_unpack(data[:usable]):
+        yield gcs_node, dict(zip(FIELDS, values[:-1]))
+
+
+def summarize(paths):
+    flows = {}
+    for path in paths:
+        for gcs_node, r in read_records(path):
+            flow = flows.setdefault(r["sourceNode"], {"records": 0, "duplicates": 0, "delay": 0.0, "hops": 0, "retransmitted": 0})
+            flow["records"] += 1
+            if r["flags"] & DUPLICATE:
+                flow["duplicates"] += 1
+                continue
+            flow["delay"] += r["delay"]
+            flow["hops"] += r["hopCount"]
+            flow["retransmitted"] += r["attempt"] > 0
+
+    print(f"{'UAV':>5} {'registros':>10} {'duplicatas':>11} {'atraso médio (s)':>17} {'saltos médios':>14} {'retransmitidos':>15}")
+    for source in sorted(flows):
+        flow = flows[source]
+        distinct = flow["records"] - flow["duplicates"]
+        delay = flow["delay"] / distinct if distinct else 0
+        hops = flow["hops"] / distinct if distinct else 0
+        print(f"{source:>5} {flow['records']:>10} {flow['duplicates']:>11} {delay:>17.4f} {hops:>14.2f} {flow['retransmitted']:>15}")
+
+
+def dump_csv(paths):
+    writer = csv.writer(sys.stdout)
+    writer.writerow(("gcsNode",) + FIELDS)
+    for path in paths:
+        for gcs_node, r in read_records(path):
+            writer.writerow([gcs_node] + [r[field] for field in FIELDS])
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Leitor da telemetria binária da GCS (FANET)")
+    parser.add_argument("files", nargs="+", help="arquivos .tlm")
+    parser.add_argument("--csv", action="store_true", help="exporta todos os registros em CSV")
+    args = parser.parse_args()
+    if args.csv:
+        dump_csv(args.files)
+    else:
+        summarize(args.files)
@@ -6,7 +6,9 @@
  */
 
 #include "ArbitraryMobility.h"
+#include "MobilityBounds.h"
 #include "inet/common/ModuleAccess.h"
+#include <algorithm>
 #include <cmath>
 
 using namespace omnetpp;
@@ -18,6 +20,10 @@ ArbitraryMobility::ArbitraryMobility()
 {
     lastUpdate = 0;
     moveTimer = nullptr;
+    eventDriven = false;
+    segmentStartTime = 0;
+    nextTurnTime = -1;
+    nextBounceTime = -1;
 }
 
 ArbitraryMobility::~ArbitraryMobility()
@@ -38,14 +44,27 @@ void ArbitraryMobility::initialize(int stage)
         minAltitude = par("minAltitude");
         maxAltitude = par("maxAltitude");
         
-        // Create movement timer
-        moveTimer = new cMessage("moveTimer");
+        // Random turns: same statistics in both modes (geometric per tick vs exponential)
+        turnProbability = par("turnProbability");
+        meanTurnInterval = par("meanTurnInterval");
+        if (meanTurnInterval < 0)
+            meanTurnInterval = turnProbability > 0 ? par("updateInterval").doubleValue() / turnProbability : -1;
+        
+        eventDriven = par("eventDriven");
+        if (eventDriven) {
+            // No periodic ticks: MovingMobilityBase schedules only at nextChange
+            updateInterval = 0;
+        }
+        else {
+            // Create movement timer
+            moveTimer = new cMessage("moveTimer");
+        }
         
         EV << "ArbitraryMobility: Boundary area: X[" << constraintAreaMinX << "," << constraintAreaMaxX 
            << "] Y[" << constraintAreaMinY << "," << constraintAreaMaxY 
            << "] Z[" << minAltitude << "," << maxAltitude << "]" << endl;
     }
-    else if (stage == INITSTAGE_LAST) {
+    else if (stage == INITSTAGE_LAST && !eventDriven) {
         // Schedule first movement update
         double updateInterval = par("updateInterval");
         scheduleAt(simTime() + updateInterval, moveTimer);
@@ -66,10 +85,22 @@ void ArbitraryMobility::setInitialPosition()
     lastVelocity = Coord(speed, 0, 0);
     
     EV << "ArbitraryMobility: setInitialPosition called with (" << x << ", " << y << ", " << z << ")" << endl;
+    
+    if (eventDriven) {
+        segmentStart = lastPosition;
+        segmentStartTime = simTime();
+        nextTurnTime = (speed > 0 && meanTurnInterval > 0) ? simTime() + exponential(meanTurnInterval, 0) : -1;
+        scheduleNextChange();
+    }
 }
 
 void ArbitraryMobility::move()
 {
+    if (eventDriven) {
+        moveAnalytically();
+        return;
+    }
+    
     simtime_t now = simTime();
     
     if (now > lastUpdate) {
@@ -81,41 +112,38 @@ void ArbitraryMobility::move()
         // Apply boundary constraints with bounce
         bool bounced = false;
         if (newPosition.x <= constraintAreaMinX) {
-            newPosition.x = constraintAreaMinX + 1; // Pequena margem para evitar oscilação
+            newPosition.x = constraintAreaMinX + BOUNDARY_MARGIN;
             lastVelocity.x = abs(lastVelocity.x); // Força direção positiva
             bounced = true;
         } else if (newPosition.x >= constraintAreaMaxX) {
-            newPosition.x = constraintAreaMaxX - 1;
+            newPosition.x = constraintAreaMaxX - BOUNDARY_MARGIN;
             lastVelocity.x = -abs(lastVelocity.x); // Força direção negativa
             bounced = true;
         }
         
         if (newPosition.y <= constraintAreaMinY) {
-            newPosition.y = constraintAreaMinY + 1;
+            newPosition.y = constraintAreaMinY + BOUNDARY_MARGIN;
             lastVelocity.y = abs(lastVelocity.y);
             bounced = true;
         } else if (newPosition.y >= constraintAreaMaxY) {
-            newPosition.y = constraintAreaMaxY - 1;
+            newPosition.y = constraintAreaMaxY - BOUNDARY_MARGIN;
             lastVelocity.y = -abs(lastVelocity.y);
             bounced = true;
         }
         
         if (newPosition.z <= minAltitude) {
-            newPosition.z = minAltitude + 1;
+            newPosition.z = minAltitude + BOUNDARY_MARGIN;
             lastVelocity.z = abs(lastVelocity.z);
             bounced = true;
         } else if (newPosition.z >= maxAltitude) {
-            newPosition.z = maxAltitude - 1;
+            newPosition.z = maxAltitude - BOUNDARY_MARGIN;
             lastVelocity.z = -abs(lastVelocity.z);
             bounced = true;
         }
         
         // Add some randomness to direction (menos frequente se acabou de rebater)
-        if (!bounced && uniform(0, 1, 0) < 0.1) { // 10% chance of direction change
-            double angle = uniform(0, 2 * M_PI, 0);
-            double speed = sqrt(lastVelocity.x * lastVelocity.x + lastVelocity.y * lastVelocity.y);
-            lastVelocity.x = speed * cos(angle);
-            lastVelocity.y = speed * sin(angle);
+        if (!bounced && uniform(0, 1, 0) < turnProbability) { // Curva com probabilidade turnProbability por passo
+            turn();
         }
         
         if (bounced) {
@@ -130,6 +158,96 @@ void ArbitraryMobility::move()
     emitMobilityStateChangedSignal();
 }
 
+void ArbitraryMobility::turn()
+{
+    // New horizontal heading, same horizontal speed
+    double angle = uniform(0, 2 * M_PI, 0);
+    double speed = sqrt(lastVelocity.x * lastVelocity.x + lastVelocity.y * lastVelocity.y);
+    lastVelocity.x = speed * cos(angle);
+    lastVelocity.y = speed * sin(angle);
+}
+
+// =============================================================================
+// EVENT-DRIVEN (ANALYTIC) MODE
+// =============================================================================
+
+// Limites efetivos recuados de BOUNDARY_MARGIN, como no modo periódico
+static double timeToBoundary(double position, double velocity, double min, double max)
+{
+    if (velocity > 0)
+        return std::max(0.0, (max - BOUNDARY_MARGIN - position) / velocity);
+    else if (velocity < 0)
+        return std::max(0.0, (min + BOUNDARY_MARGIN - position) / velocity);
+    else
+        return INFINITY;
+}
+
+static bool bounceAxis(double& position, double& velocity, double min, double max)
+{
+    const double epsilon = 1e-6;  // simtime rounding at the boundary
+    if (velocity > 0 && position >= max - BOUNDARY_MARGIN - epsilon) {
+        position = max - BOUNDARY_MARGIN;
+        velocity = -velocity;
+        return true;
+    }
+    else if (velocity < 0 && position <= min + BOUNDARY_MARGIN + epsilon) {
+        position = min + BOUNDARY_MARGIN;
+        velocity = -velocity;
+        return true;
+    }
+    return false;
+}
+
+void ArbitraryMobility::moveAnalytically()
+{
+    simtime_t now = simTime();
+    
+    // Apply every state change due up to now, in order
+    while (nextChange != -1 && nextChange <= now) {
+        segmentStart = segmentStart + lastVelocity * (nextChange - segmentStartTime).dbl();
+        segmentStartTime = nextChange;
+        applyStateChange();
+        scheduleNextChange();
+    }
+    
+    // Linear motion inside the current segment
+    lastPosition = segmentStart + lastVelocity * (now - segmentStartTime).dbl();
+}
+
+void ArbitraryMobility::applyStateChange()
+{
+    if (nextBounceTime != -1 && nextBounceTime <= segmentStartTime) {
+        bool bounced = bounceAxis(segmentStart.x, lastVelocity.x, constraintAreaMinX, constraintAreaMaxX);
+        bounced |= bounceAxis(segmentStart.y, lastVelocity.y, constraintAreaMinY, constraintAreaMaxY);
+        bounced |= bounceAxis(segmentStart.z, lastVelocity.z, minAltitude, maxAltitude);
+        if (bounced) {
+            EV << "ArbitraryMobility: UAV bounced at position (" << segmentStart.x 
+               << ", " << segmentStart.y << ", " << segmentStart.z << ")" << endl;
+        }
+    }
+    
+    if (nextTurnTime != -1 && nextTurnTime <= segmentStartTime) {
+        turn();
+        nextTurnTime = segmentStartTime + exponential(meanTurnInterval, 0);
+    }
+}
+
+void ArbitraryMobility::scheduleNextChange()
+{
+    // Closed-form time to the first boundary hit, per axis
+    double t = std::min(timeToBoundary(segmentStart.x, lastVelocity.x, constraintAreaMinX, constraintAreaMaxX),
+               std::min(timeToBoundary(segmentStart.y, lastVelocity.y, constraintAreaMinY, constraintAreaMaxY),
+                        timeToBoundary(segmentStart.z, lastVelocity.z, minAltitude, maxAltitude)));
+    nextBounceTime = std::isinf(t) ? -1 : segmentStartTime + t;
+    
+    if (nextBounceTime == -1)
+        nextChange = nextTurnTime;
+    else if (nextTurnTime == -1)
+        nextChange = nextBounceTime;
+    else
+        nextChange = std::min(nextBounceTime, nextTurnTime);
+}
+
 void ArbitraryMobility::orient()
 {
     // Basic orientation - can be enhanced later
@@ -27,6 +27,17 @@ private:
     
     // Timer for periodic updates
     cMessage *moveTimer;
+    
+    // Random turn parameters
+    double turnProbability;     // Per-tick turn probability (fixed-step mode)
+    double meanTurnInterval;    // Mean time between turns (event-driven mode)
+    
+    // Event-driven (analytic) mode: linear segment since the last state change
+    bool eventDriven;
+    Coord segmentStart;
+    simtime_t segmentStartTime;
+    simtime_t nextTurnTime;
+    simtime_t nextBounceTime;
 
 protected:
     virtual void initialize(int stage) override;
@@ -35,6 +46,12 @@ protected:
     virtual void orient() override;
     virtual void finish() override;
     virtual void handleSelfMessage(cMessage *message) override;
+    
+    // Event-driven mode helpers
+    virtual void moveAnalytically();
+    virtual void applyStateChange();
+    virtual void scheduleNextChange();
+    virtual void turn();
 
 public:
     ArbitraryMobility();
@@ -0,0 +1,62 @@
+/*
+ * ChunkPool.h
+ *
+ * Pool de chunks reutilizáveis para as mensagens periódicas da FANET
+ *
+ * Chunks inseridos em um pacote ficam imutáveis e são compartilhados pelas
+ * cópias (MAC, receptores). Um chunk do pool volta a ser mutável e é
+ * reutilizado quando o pool detém a única referência, isto é, quando todos
+ * os pacotes que o carregavam já foram destruídos. Sem chunk livre, um novo
+ * é alocado (e retido, até a capacidade).
+ */
+
+#ifndef CHUNKPOOL_H_
+#define CHUNKPOOL_H_
+
+#include "inet/common/INETDefs.h"
+#include "inet/common/packet/chunk/Chunk.h"
+#include <vector>
+
+using namespace omnetpp;
+using namespace inet;
+
+template <typename T>
+class ChunkPool {
+  private:
+    std::vector<Ptr<T>> chunks;   // Chunks retidos pelo pool
+    size_t capacity;              // 0 = sem pool (sempre aloca)
+    size_t next;                  // Início da busca (rotativo)
+    long allocations;             // Chunks alocados
+    long reuses;                  // Chunks reaproveitados
+
+  public:
+    ChunkPool() : capacity(0), next(0), allocations(0), reuses(0) {}
+
+    void setCapacity(size_t capacity) { this->capacity = capacity; chunks.reserve(capacity); }
+
+    // Chunk mutável: um livre do pool (campos antigos devem ser sobrescritos
+    // pelo chamador) ou recém-alocado
+    Ptr<T> acquire() {
+        for (size_t i = 0; i < chunks.size(); i++) {
+            Ptr<T>& chunk = chunks[(next + i) % chunks.size()];
+            if (chunk.use_count() == 1) {
+                next = (next + i + 1) % chunks.size();
+                chunk->markMutableIfExclusivelyOwned();
+                reuses++;
+                return chunk;
+            }
+        }
+
+        auto chunk = makeShared<T>();
+        allocations++;
+        if (chunks.size() < capacity)
+            chunks.push_back(chunk);
+        return chunk;
+    }
+
+    long getAllocations() const { return allocations; }
+    long getReuses() const { return reuses; }
+    size_t size() const { return chunks.size(); }
+};
+
+#endif /* CHUNKPOOL_H_ */
@@ -0,0 +1,52 @@
+/*
+ * DuplicateCache.cc
+ *
+ * Implementação do cache de duplicatas da telemetria encaminhada
+ */
+
+#include "DuplicateCache.h"
+
+using namespace omnetpp;
+using namespace inet;
+
+void DuplicateCache::initialize(size_t capacity, simtime_t lifetime) {
+    slots.assign(capacity, Entry());
+    keys.clear();
+    keys.reserve(capacity);
+    this->lifetime = lifetime;
+    head = 0;
+    count = 0;
+}
+
+bool DuplicateCache::checkAndInsert(uint16_t sourceNode, uint32_t sequence, uint8_t attempt, simtime_t now) {
+    if (slots.empty())
+        return false;
+
+    expire(now);
+    uint64_t key = makeKey(sourceNode, sequence, attempt);
+    if (keys.count(key))
+        return true;
+
+    if (count == slots.size())
+        popOldest();
+    Entry& entry = slots[(head + count) % slots.size()];
+    entry.key = key;
+    entry.insertedAt = now;
+    keys.insert(key);
+    count++;
+    return false;
+}
+
+void DuplicateCache::expire(simtime_t now) {
+    // Anel em ordem de inserção: expiradas estão sempre no início
+    if (lifetime <= 0)
+        return;
+    while (count > 0 && slots[head].insertedAt + lifetime <= now)
+        popOldest();
+}
+
+void DuplicateCache::popOldest() {
+    keys.erase(slots[head].key);
+    head = (head + 1) % slots.size();
+    count--;
+}
@@ -0,0 +1,56 @@
+/*
+ * DuplicateCache.h
+ *
+ * Cache de duplicatas da telemetria encaminhada pela aplicação FANET
+ *
+ * - Chave (origem, sequência, tentativa) compactada em 64 bits: retransmissões
+ *   da origem não são confundidas com cópias da mesma transmissão
+ * - Anel FIFO com capacidade fixa alocado uma única vez + índice hash
+ * - Janela de tempo: entradas mais antigas que lifetime deixam de valer
+ */
+
+#ifndef DUPLICATECACHE_H_
+#define DUPLICATECACHE_H_
+
+#include "inet/common/INETDefs.h"
+#include <unordered_set>
+#include <vector>
+
+using namespace omnetpp;
+using namespace inet;
+
+class DuplicateCache {
+  private:
+    struct Entry {
+        uint64_t key;
+        simtime_t insertedAt;
+    };
+
+    std::vector<Entry> slots;               // Anel pré-alocado (ordem de inserção)
+    std::unordered_set<uint64_t> keys;      // Chaves válidas no anel
+    size_t head;                            // Entrada mais antiga
+    size_t count;
+    simtime_t lifetime;                     // Janela de validade (0 = até sair do anel)
+
+    static uint64_t makeKey(uint16_t sourceNode, uint32_t sequence, uint8_t attempt) {
+        return ((uint64_t)attempt << 48) | ((uint64_t)sourceNode << 32) | sequence;
+    }
+    void expire(simtime_t now);
+    void popOldest();
+
+  public:
+    DuplicateCache() : head(0), count(0), lifetime(0) {}
+
+    // Aloca o anel (0 entradas = desligado)
+    void initialize(size_t capacity, simtime_t lifetime);
+
+    // true se (origem, sequência, tentativa) já foi vista na janela; senão
+    // registra e retorna false (com o anel cheio, a entrada mais antiga sai)
+    bool checkAndInsert(uint16_t sourceNode, uint32_t sequence, uint8_t attempt, simtime_t now);
+
+    bool isEnabled() const { return !slots.empty(); }
+    size_t size() const { return count; }
+    size_t getCapacity() const { return slots.size(); }
+};
+
+#endif /* DUPLICATECACHE_H_ */
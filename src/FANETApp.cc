@@ -22,10 +22,16 @@
 
 #include "FANETApp.h"
 #include "inet/networklayer/common/L3AddressResolver.h"
+#include "inet/networklayer/common/L3Tools.h"
 #include "inet/common/ModuleAccess.h"
+#include "inet/common/Simsignals.h"
 #include "inet/common/packet/Packet.h"
-#include "inet/common/packet/chunk/cPacketChunk.h"
-#include <sstream>
+#include "inet/networklayer/ipv4/Ipv4InterfaceData.h"
+#include "inet/physicallayer/wireless/common/contract/packetlevel/IRadio.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
 
 using namespace omnetpp;
 using namespace inet;
@@ -40,14 +46,24 @@ FANETApp::~FANETApp() {
     cancelAndDelete(neighborDiscoveryTimer);
     cancelAndDelete(dataTransmissionTimer);
     cancelAndDelete(connectivityCheckTimer);
+    cancelAndDelete(beaconIntervalTimer);
+    cancelAndDelete(aggregationTimer);
+    cancelAndDelete(channelStatsTimer);
+    cancelAndDelete(retransmitTimer);
+    cancelAndDelete(txReleaseTimer);
+    txScheduler.clear();
 }
 
 void FANETApp::initialize(int stage) {
     ApplicationBase::initialize(stage);
     
     if (stage == INITSTAGE_LOCAL) {
+        nodeIndex = getContainingNode(this)->getIndex();
+        sequenceNumber = 0;
+        telemetrySequence = 0;
+        
         EV << "FANET Init: " << (par("isGCS").boolValue() ? "GCS" : "UAV") 
-           << " " << getIndex() << endl;
+           << " " << nodeIndex << endl;
         
         // Leitura de parâmetros
         localPort = par("localPort");
@@ -55,10 +71,130 @@ void FANETApp::initialize(int stage) {
         startTime = par("startTime");
         neighborTimeout = par("neighborTimeout");
         maxTransmissionRange = par("maxTransmissionRange");
+        deadReckoning = par("deadReckoning");
+        predictionHorizon = par("predictionHorizon");
+        lastPredictionUpdate = -1;
         isGCS = par("isGCS");
+        neighbors.setTimeout(neighborTimeout);
+        gradientRouting = !strcmp(par("relayMode").stringValue(), "gradient");
+        geographicRouting = !strcmp(par("relayMode").stringValue(), "geographic");
+        gcsPositionKnown = false;
+        bool leastLoaded = !strcmp(par("gcsSelection").stringValue(), "leastLoaded");
+        neighbors.setGCSMetric(leastLoaded ? NeighborTable::GCS_LEAST_LOADED : NeighborTable::GCS_NEAREST);
+        gcsLoad = 0;
+        recentDataPackets = 0;
+        lastLoadUpdate = 0;
+        aggregationDelay = par("aggregationDelay");
+        maxAggregatedRecords = par("maxAggregatedRecords");
+        if (maxAggregatedRecords < 1)
+            throw cRuntimeError("maxAggregatedRecords must be at least 1");
+        
+        // Anel alocado uma única vez
+        bool priorityEviction = !strcmp(par("storeEviction").stringValue(), "priority");
+        store.initialize(par("storeCapacity").intValue(), par("storeMaxBytes").intValue(),
+                         priorityEviction ? TelemetryStore::EVICT_PRIORITY : TelemetryStore::EVICT_DROP_OLDEST);
+        
+        // Ingestão da GCS: um arquivo por GCS e execução (<prefixo>-gcsN.tlm)
+        std::string telemetryLogPrefix = par("telemetryLog").stdstringValue();
+        if (isGCS && !telemetryLogPrefix.empty()) {
+            std::string path = telemetryLogPrefix + "-gcs" + std::to_string(nodeIndex) + ".tlm";
+            std::filesystem::path directory = std::filesystem::path(path).parent_path();
+            if (!directory.empty())
+                std::filesystem::create_directories(directory);
+            telemetryLog.open(path, par("telemetryLogBatch").intValue(), nodeIndex);
+            EV << "Telemetry log: " << path << endl;
+        }
+        linkEstimation = par("linkEstimation");
+        linkAlpha = par("linkAlpha");
+        if (linkAlpha <= 0 || linkAlpha > 1)
+            throw cRuntimeError("linkAlpha must be in (0, 1]");
+        beaconSequence = 0;
+        duplicateCache.initialize(par("duplicateCacheSize").intValue(), par("duplicateCacheLifetime"));
+        
+        // Telemetria confiável (janela, RTO adaptativo e ACKs nos beacons)
+        reliableTelemetry = par("reliableTelemetry");
+        retransmitWindowSize = par("retransmitWindow");
+        maxRetransmissions = par("maxRetransmissions");
+        minRto = par("minRto");
+        maxRto = par("maxRto");
+        rto = par("initialRto");
+        maxAckBlocks = par("maxAckBlocks");
+        ackLifetime = par("ackLifetime");
+        srtt = 0;
+        rttvar = 0;
+        hasRttSample = false;
+        if (reliableTelemetry && retransmitWindowSize < 1)
+            throw cRuntimeError("retransmitWindow must be at least 1");
+        if (maxRetransmissions < 0 || maxRetransmissions > 255)
+            throw cRuntimeError("maxRetransmissions must be in [0, 255]");
+        if (minRto <= 0 || maxRto < minRto)
+            throw cRuntimeError("Invalid RTO range [%s, %s]", minRto.str().c_str(), maxRto.str().c_str());
+        
+        // Pools por tipo: chunks retidos para as mensagens periódicas
+        int chunkPoolSize = par("chunkPoolSize");
+        for (int type = NEIGHBOR_DISCOVERY; type <= AGGREGATED_DATA; type++)
+            headerPools[type].setCapacity(chunkPoolSize);
+        sensorDataPool.setCapacity(chunkPoolSize);
+        recordHeaderPool.setCapacity(chunkPoolSize);
+        neighbors.setRelayMetric(gradientRouting ? NeighborTable::RELAY_GRADIENT : NeighborTable::RELAY_NEAREST);
+        neighborDiscoveryInterval = par("neighborDiscoveryInterval");
+        dataTransmissionInterval = par("dataTransmissionInterval");
+        connectivityCheckInterval = par("connectivityCheckInterval");
+        
+        // Beaconing adaptativo (Trickle)
+        adaptiveBeaconing = !strcmp(par("beaconingMode").stringValue(), "adaptive");
+        beaconIntervalMin = par("beaconIntervalMin");
+        beaconIntervalMax = par("beaconIntervalMax");
+        beaconRedundancy = par("beaconRedundancy");
+        beaconPositionThreshold = par("beaconPositionThreshold");
+        beaconInterval = 0;
+        beaconsHeard = 0;
+        lastBeaconTime = 0;
+        if (adaptiveBeaconing && (beaconIntervalMin <= 0 || beaconIntervalMax < beaconIntervalMin))
+            throw cRuntimeError("Invalid beacon interval range [%s, %s]", beaconIntervalMin.str().c_str(), beaconIntervalMax.str().c_str());
+        if (adaptiveBeaconing && 2 * beaconIntervalMax >= neighborTimeout)
+            throw cRuntimeError("beaconIntervalMax must be less than half of neighborTimeout");
+        
+        // Escalonamento: deslocamento de cada nó dentro do período
+        jitterScheduling = !strcmp(par("txScheduling").stringValue(), "jitter");
+        slottedScheduling = !strcmp(par("txScheduling").stringValue(), "slotted");
+        txJitter = par("txJitter");
+        numTxSlots = par("numTxSlots");
+        if (txJitter < 0 || txJitter > 1)
+            throw cRuntimeError("txJitter must be in [0, 1]");
+        if (numTxSlots < 1)
+            throw cRuntimeError("numTxSlots must be at least 1");
+        txSlot = intuniform(0, numTxSlots - 1);
+        slotOccupancy.assign(numTxSlots, 0);
+        
+        // Filas de transmissão por classe (prioridade estrita ou ponderada)
+        const char *txSchedulerMode = par("txScheduler").stringValue();
+        txQueueing = strcmp(txSchedulerMode, "none") != 0;
+        txPacing = par("txPacing");
+        macQueueLimit = par("macQueueLimit");
+        macQueue = nullptr;
+        if (txQueueing) {
+            std::vector<int> weights = cStringTokenizer(par("txClassWeights").stringValue()).asIntVector();
+            bool weighted = !strcmp(txSchedulerMode, "weighted");
+            if (weighted && (weights.size() != NUM_TX_CLASSES || *std::min_element(weights.begin(), weights.end()) < 1))
+                throw cRuntimeError("txClassWeights must have %d weights >= 1", NUM_TX_CLASSES);
+            if (par("txQueueCapacity").intValue() < 1)
+                throw cRuntimeError("txQueueCapacity must be at least 1");
+            if (txPacing <= 0)
+                throw cRuntimeError("txPacing must be positive");
+            txScheduler.initialize(par("txQueueCapacity").intValue(), weighted, weights);
+            macQueue = findModuleFromPar<queueing::IPacketQueue>(par("macQueueModule"), this);
+            registerTxClassSignals();
+        }
+        slotChanges = 0;
+        channelReceiving = false;
+        channelTransmitting = false;
+        channelBusySince = 0;
+        channelBusyTime = 0;
+        periodCollisions = 0;
         
         // Log dos parâmetros carregados
-        EV << "FANET Config: " << (isGCS ? "GCS" : "UAV") << getIndex() 
+        EV << "FANET Config: " << (isGCS ? "GCS" : "UAV") << nodeIndex 
            << " maxRange=" << maxTransmissionRange << "m" 
            << " port=" << localPort << endl;
         
@@ -67,6 +203,27 @@ void FANETApp::initialize(int stage) {
         packetsSent = 0;
         dataPacketsReceived = 0;
         dataPacketsSent = 0;
+        selfPacketsDropped = 0;
+        beaconsSent = 0;
+        beaconsSuppressed = 0;
+        relayTransmissions = 0;
+        relayChoiceDiffers = 0;
+        relayFailures = 0;
+        hopLimitDrops = 0;
+        predictedEvictions = 0;
+        telemetryGenerated = 0;
+        duplicateRecords = 0;
+        perimeterEntries = 0;
+        perimeterLoops = 0;
+        aggregatedFrames = 0;
+        storeEvictions = 0;
+        storedRecords = 0;
+        unicastFailures = 0;
+        duplicatesSuppressed = 0;
+        retransmissions = 0;
+        retransmitGiveUps = 0;
+        telemetryAcked = 0;
+        maxHopsSaved = 0;
         
         // Registro de sinais
         packetsReceivedSignal = registerSignal("packetsReceived");
@@ -74,20 +231,95 @@ void FANETApp::initialize(int stage) {
         dataPacketsReceivedSignal = registerSignal("dataPacketsReceived");
         dataPacketsSentSignal = registerSignal("dataPacketsSent");
         neighborsFoundSignal = registerSignal("neighborsFound");
+        selfPacketsDroppedSignal = registerSignal("selfPacketsDropped");
+        neighborCoverageSignal = registerSignal("neighborCoverage");
+        beaconsSentSignal = registerSignal("beaconsSent");
+        beaconsSuppressedSignal = registerSignal("beaconsSuppressed");
+        beaconIntervalSignal = registerSignal("beaconInterval");
+        neighborAgeSignal = registerSignal("neighborAge");
+        relayTransmissionsSignal = registerSignal("relayTransmissions");
+        relayChoiceDiffersSignal = registerSignal("relayChoiceDiffers");
+        relayFailuresSignal = registerSignal("relayFailures");
+        hopLimitDropsSignal = registerSignal("hopLimitDrops");
+        predictedEvictionsSignal = registerSignal("predictedEvictions");
+        telemetryGeneratedSignal = registerSignal("telemetryGenerated");
+        duplicateRecordsSignal = registerSignal("duplicateRecords");
+        sequenceGapSignal = registerSignal("sequenceGap");
+        peakAoiSignal = registerSignal("peakAoi");
+        deliveredHopCountSignal = registerSignal("deliveredHopCount");
+        perimeterEntriesSignal = registerSignal("perimeterEntries");
+        perimeterLoopsSignal = registerSignal("perimeterLoops");
+        gcsLoadSignal = registerSignal("gcsLoad");
+        dataLatencySignal = registerSignal("dataLatency");
+        aggregatedFramesSignal = registerSignal("aggregatedFrames");
+        recordsPerFrameSignal = registerSignal("recordsPerFrame");
+        aggregationWaitSignal = registerSignal("aggregationWait");
+        storeOccupancySignal = registerSignal("storeOccupancy");
+        storeSojournSignal = registerSignal("storeSojourn");
+        storeEvictionsSignal = registerSignal("storeEvictions");
+        storedRecordsSignal = registerSignal("storedRecords");
+        linkEtxSignal = registerSignal("linkEtx");
+        beaconDeliveryRatioSignal = registerSignal("beaconDeliveryRatio");
+        unicastFailuresSignal = registerSignal("unicastFailures");
+        relayLinkEtxSignal = registerSignal("relayLinkEtx");
+        duplicatesSuppressedSignal = registerSignal("duplicatesSuppressed");
+        maxHopsSavedSignal = registerSignal("maxHopsSaved");
+        slotChangesSignal = registerSignal("slotChanges");
+        txBacklogSignal = registerSignal("txBacklog");
+        retransmissionsSignal = registerSignal("retransmissions");
+        retransmitGiveUpsSignal = registerSignal("retransmitGiveUps");
+        telemetryAckedSignal = registerSignal("telemetryAcked");
+        ackRttSignal = registerSignal("ackRtt");
+        rtoSignal = registerSignal("rto");
+        ackBlocksSignal = registerSignal("ackBlocks");
+        channelBusySignal = registerSignal("channelBusy");
+        collisionsSignal = registerSignal("collisions");
         
         // Criação de timers
         neighborDiscoveryTimer = new cMessage("neighborDiscoveryTimer");
         dataTransmissionTimer = new cMessage("dataTransmissionTimer");
         connectivityCheckTimer = new cMessage("connectivityCheckTimer");
+        beaconIntervalTimer = new cMessage("beaconIntervalTimer");
+        aggregationTimer = new cMessage("aggregationTimer");
+        channelStatsTimer = nullptr;
+        retransmitTimer = new cMessage("retransmitTimer");
+        txReleaseTimer = new cMessage("txReleaseTimer");
         
         // Obter referência para módulo de mobilidade
         mobility = check_and_cast<IMobility *>(getModuleByPath("^.mobility"));
+        maxHopCount = par("maxHopCount");
+        if (maxHopCount < 0)
+            maxHopCount = deriveMaxHopCount();
+        else if (maxHopCount < 1 || maxHopCount > 255)
+            throw cRuntimeError("maxHopCount must be in [1, 255] or negative (derived)");
+        EV << "Max hop count: " << maxHopCount << endl;
+        spatialGrid = findModuleFromPar<SpatialGrid>(par("spatialGridModule"), this);
+        
+        // Endereços próprios: resolvidos uma vez e atualizados por sinal
+        cModule *node = getContainingNode(this);
+        interfaceTable = L3AddressResolver().findInterfaceTableOf(node);
+        node->subscribe(interfaceCreatedSignal, this);
+        node->subscribe(interfaceDeletedSignal, this);
+        node->subscribe(interfaceIpv4ConfigChangedSignal, this);
+        
+        // Falhas de unicast: limite de retransmissões do MAC (sem MAC, nunca emitido)
+        if (linkEstimation)
+            node->subscribe(linkBrokenSignal, this);
+        
+        // Ocupação do canal e quadros corrompidos: apenas com rádio (pilha completa)
+        if (interfaceTable != nullptr) {
+            node->subscribe(physicallayer::IRadio::receptionStateChangedSignal, this);
+            node->subscribe(physicallayer::IRadio::transmissionStateChangedSignal, this);
+            node->subscribe(packetDroppedSignal, this);
+            channelStatsTimer = new cMessage("channelStatsTimer");
+        }
     }
     else if (stage == INITSTAGE_APPLICATION_LAYER) {
+        refreshLocalAddresses();
         configureSocket();
         scheduleTimers();
         
-        EV << "FANET ready: " << (isGCS ? "GCS" : "UAV") << " " << getIndex() 
+        EV << "FANET ready: " << (isGCS ? "GCS" : "UAV") << " " << nodeIndex 
            << " at " << mobility->getCurrentPosition() << endl;
     }
 }
@@ -102,15 +334,30 @@ void FANETApp::configureSocket() {
 }
 
 void FANETApp::scheduleTimers() {
-    // Descoberta de vizinhos a cada 10 segundos
-    scheduleAt(startTime + uniform(1, 3), neighborDiscoveryTimer);
+    // Descoberta de vizinhos: periódica ou intervalos Trickle (primeiro com Imin)
+    bool scheduled = jitterScheduling || slottedScheduling;
+    if (adaptiveBeaconing)
+        scheduleAt(startTime + uniform(1, 3), beaconIntervalTimer);
+    else if (scheduled)
+        scheduleAt(firstTransmissionTime(neighborDiscoveryInterval), neighborDiscoveryTimer);
+    else
+        scheduleAt(startTime + uniform(1, 3), neighborDiscoveryTimer);
     
-    // Transmissão de dados apenas para UAVs (a cada 15 segundos)
+    // Transmissão de dados apenas para UAVs
     if (!isGCS) {
-        scheduleAt(startTime + uniform(5, 8), dataTransmissionTimer);
+        if (scheduled)
+            scheduleAt(firstTransmissionTime(dataTransmissionInterval), dataTransmissionTimer);
+        else
+            scheduleAt(startTime + uniform(5, 8), dataTransmissionTimer);
+    }
+    
+    // Estatísticas do canal por período de beacon (alinhado a múltiplos do período)
+    if (channelStatsTimer != nullptr) {
+        channelBusySince = simTime();
+        scheduleAt(neighborDiscoveryInterval * (floor(simTime() / neighborDiscoveryInterval) + 1), channelStatsTimer);
     }
     
-    // Verificação de conectividade a cada 30 segundos
+    // Verificação de conectividade
     scheduleAt(startTime + uniform(10, 15), connectivityCheckTimer);
 }
 
@@ -120,16 +367,41 @@ void FANETApp::scheduleTimers() {
 
 void FANETApp::handleMessageWhenUp(cMessage *msg) {
     if (msg == neighborDiscoveryTimer) {
-        sendNeighborDiscovery();
-        scheduleAt(simTime() + 10, neighborDiscoveryTimer);  // Repetir a cada 10s
+        if (adaptiveBeaconing) {
+            handleBeaconTimer();
+        }
+        else {
+            if (slottedScheduling)
+                updateTxSlot();
+            sendNeighborDiscovery();
+            scheduleAt(nextTransmissionTime(neighborDiscoveryInterval), neighborDiscoveryTimer);
+        }
+    }
+    else if (msg == beaconIntervalTimer) {
+        // Fim do intervalo: dobrar até Imax (o primeiro intervalo usa Imin)
+        beaconInterval = beaconInterval == 0 ? beaconIntervalMin : std::min(2 * beaconInterval, beaconIntervalMax);
+        startBeaconInterval();
+    }
+    else if (msg == aggregationTimer) {
+        flushAggregationBuffer();
     }
     else if (msg == dataTransmissionTimer) {
         sendSensorData();
-        scheduleAt(simTime() + 15, dataTransmissionTimer);   // Repetir a cada 15s
+        scheduleAt(nextTransmissionTime(dataTransmissionInterval), dataTransmissionTimer);
+    }
+    else if (msg == txReleaseTimer) {
+        releaseTransmission();
+    }
+    else if (msg == retransmitTimer) {
+        handleRetransmitTimer();
+    }
+    else if (msg == channelStatsTimer) {
+        recordChannelPeriod();
+        scheduleAt(simTime() + neighborDiscoveryInterval, channelStatsTimer);
     }
     else if (msg == connectivityCheckTimer) {
         checkConnectivity();
-        scheduleAt(simTime() + 30, connectivityCheckTimer); // Repetir a cada 30s
+        scheduleAt(simTime() + connectivityCheckInterval, connectivityCheckTimer);
     }
     else if (msg->isSelfMessage()) {
         EV << "Unknown self-message: " << msg->getName() << endl;
@@ -148,31 +420,40 @@ void FANETApp::handleMessageWhenUp(cMessage *msg) {
 void FANETApp::sendNeighborDiscovery() {
     Coord myPosition = mobility->getCurrentPosition();
     
-    EV << "Starting neighbor discovery: " << (isGCS ? "GCS" : "UAV") << getIndex() 
+    EV << "Starting neighbor discovery: " << (isGCS ? "GCS" : "UAV") << nodeIndex 
        << " @ (" << (int)myPosition.x << "," << (int)myPosition.y << "," << (int)myPosition.z << ")" << endl;
     
-    // Criar mensagem de descoberta
-    cPacket *packet = createFANETMessage(NEIGHBOR_DISCOVERY, "NEIGHBOR_DISCOVERY");
-    
-    // Adicionar informações de posição
-    char posInfo[100];
-    sprintf(posInfo, "%.2f,%.2f,%.2f,%s", 
-            myPosition.x, myPosition.y, myPosition.z, 
-            isGCS ? "GCS" : "UAV");
-    packet->addPar("positionInfo") = posInfo;
+    // GCS anuncia a carga atual no beacon
+    if (isGCS)
+        updateGCSLoad();
     
-    // Enviar via broadcast
+    // Criar mensagem de descoberta (cabeçalho já carrega a posição)
     Packet *discoveryPacket = new Packet("FANETDiscovery");
-    discoveryPacket->insertAtBack(makeShared<cPacketChunk>(packet));
+    Ptr<FanetHeader> header;
+    if (geographicRouting && gcsPositionKnown)
+        header = createGeoHeader(NEIGHBOR_DISCOVERY);  // Divulga a posição da GCS
+    else
+        header = createFANETHeader(NEIGHBOR_DISCOVERY);
     
-    EV << "Broadcasting discovery to 255.255.255.255:" << destPort << endl;
-    socket.sendTo(discoveryPacket, Ipv4Address::ALLONES_ADDRESS, destPort);
+    // Sequência exclusiva dos beacons: lacunas no receptor são beacons perdidos
+    header->setSequenceNumber(beaconSequence++);
+    discoveryPacket->insertAtBack(header);
     
-    packetsSent++;
-    emit(packetsSentSignal, packetsSent);
+    // Telemetria confiável: estados de recepção pegam carona no beacon
+    if (reliableTelemetry)
+        appendAckBlocks(discoveryPacket);
+    
+    // Enviar via broadcast
+    EV << "Broadcasting discovery to 255.255.255.255:" << destPort << endl;
+    sendFANETPacket(discoveryPacket, Ipv4Address::ALLONES_ADDRESS);
     
-    EV << "Discovery sent: " << (isGCS ? "GCS" : "UAV") << " " << getIndex() 
+    EV << "Discovery sent: " << (isGCS ? "GCS" : "UAV") << " " << nodeIndex 
        << " @ (" << (int)myPosition.x << "," << (int)myPosition.y << ")" << endl;
+    
+    lastBeaconTime = simTime();
+    lastBeaconPosition = myPosition;
+    beaconsSent++;
+    emit(beaconsSentSignal, beaconsSent);
 }
 
 void FANETApp::sendSensorData() {
@@ -181,81 +462,150 @@ void FANETApp::sendSensorData() {
     
     Coord myPos = mobility->getCurrentPosition();
     
-    // Criar dados simulados de sensores
-    char sensorData[200];
-    sprintf(sensorData, "UAV_%d_SENSOR: Pos(%.1f,%.1f,%.1f) Temp:%.1f Bat:%.0f%% T:%.2f", 
-            getIndex(), myPos.x, myPos.y, myPos.z, 
-            uniform(20, 35), uniform(60, 100), simTime().dbl());
+    // Criar dados simulados de sensores (todos os campos reescritos: chunk do pool)
+    auto sensorData = sensorDataPool.acquire();
+    sensorData->setPositionX(myPos.x);
+    sensorData->setPositionY(myPos.y);
+    sensorData->setPositionZ(myPos.z);
+    sensorData->setTemperature(uniform(20, 35));
+    sensorData->setBattery(uniform(60, 100));
+    sensorData->setSampleTime(simTime());
+    
+    // Toda amostra consome uma sequência, mesmo se descartada (lacuna visível na GCS)
+    uint32_t sampleSequence = telemetrySequence++;
+    duplicateCache.checkAndInsert(nodeIndex, sampleSequence, 0, simTime());  // Retorno ao próprio nó é laço
+    telemetryGenerated++;
+    emit(telemetryGeneratedSignal, telemetryGenerated);
+    
+    transmitSample(sensorData, sampleSequence, 0, simTime());
     
+    // Telemetria confiável: aguarda ACK na janela de retransmissão
+    if (reliableTelemetry)
+        addPendingSample(sensorData, sampleSequence);
+}
+
+void FANETApp::transmitSample(const Ptr<const FanetSensorData>& sensorData, uint32_t sequence, uint8_t attempt, simtime_t timestamp) {
+    // dataPacketsSent conta amostras (attempt 0); retransmissões ficam em retransmissions
     L3Address gcsAddr = findGCSAddress();
     
     // Verificar se GCS está realmente no alcance (dupla verificação)
-    bool canReachGCS = false;
-    if (!gcsAddr.isUnspecified()) {
-        for (const auto& neighbor : neighbors) {
-            if (neighbor.first == gcsAddr && neighbor.second.distance <= maxTransmissionRange) {
-                canReachGCS = true;
-                break;
-            }
-        }
-    }
+    const NeighborInfo *gcs = neighbors.getBestGCS();
+    bool canReachGCS = gcs != nullptr && gcs->distance <= maxTransmissionRange;
     
     if (canReachGCS) {
         // Envio direto para GCS
-        cPacket *packet = createFANETMessage(SENSOR_DATA, "SENSOR_DATA");
-        packet->addPar("data") = sensorData;
-        packet->addPar("sourceUAV") = getIndex();
-        
         Packet *sensorPacket = new Packet("FANETSensorData");
-        sensorPacket->insertAtBack(makeShared<cPacketChunk>(packet));
-        socket.sendTo(sensorPacket, gcsAddr, destPort);
+        auto header = createFANETHeader(SENSOR_DATA);
+        header->setSequenceNumber(sequence);
+        header->setTimestamp(timestamp);
+        header->setAttempt(attempt);
+        sensorPacket->insertAtBack(header);
+        sensorPacket->insertAtBack(sensorData);
+        sendFANETPacket(sensorPacket, gcsAddr);
+        
+        if (attempt == 0) {
+            dataPacketsSent++;
+            emit(dataPacketsSentSignal, dataPacketsSent);
+        }
+        
+        EV << "Sensor data sent: UAV" << nodeIndex << " → GCS (direct)" << endl;
+    }
+    else if (aggregationDelay > 0) {
+        // Sem caminho direto: entra no buffer de agregação com os registros retidos
+        bufferRecord(createLocalRecord(sensorData, sequence, attempt, timestamp));
+        armAggregationTimer();
         
-        dataPacketsSent++;
-        emit(dataPacketsSentSignal, dataPacketsSent);
+        if (attempt == 0) {
+            dataPacketsSent++;
+            emit(dataPacketsSentSignal, dataPacketsSent);
+        }
         
-        EV << "Sensor data sent: UAV" << getIndex() << " → GCS (direct)" << endl;
+        EV << "Sensor data buffered for aggregation: UAV" << nodeIndex << endl;
     }
     else {
         // Usar relay quando GCS não está no alcance
-        L3Address relayAddr = findBestRelayToGCS();
+        L3Address relayAddr;
+        Ptr<FanetHeader> relayHeader;
+        if (geographicRouting && gcsPositionKnown) {
+            auto geoHeader = createGeoHeader(DATA_RELAY);
+            relayAddr = findGeographicNextHop(geoHeader, L3Address());
+            relayHeader = geoHeader;
+        }
+        else {
+            relayAddr = findBestRelayToGCS();
+        }
         
         if (!relayAddr.isUnspecified()) {
-            cPacket *packet = createFANETMessage(DATA_RELAY, "DATA_RELAY");
-            packet->addPar("data") = sensorData;
-            packet->addPar("sourceUAV") = getIndex();
-            packet->addPar("finalDestination") = "GCS";
-            packet->addPar("hopCount") = 1;
+            recordRelayChoice(relayAddr);
+            if (relayHeader == nullptr)
+                relayHeader = createFANETHeader(DATA_RELAY);
+            relayHeader->setSequenceNumber(sequence);
+            relayHeader->setTimestamp(timestamp);
+            relayHeader->setAttempt(attempt);
+            sendDataRelay(relayHeader, sensorData, relayAddr);
             
-            sendDataRelay(packet, relayAddr);
+            if (attempt == 0) {
+                dataPacketsSent++;
+                emit(dataPacketsSentSignal, dataPacketsSent);
+            }
             
-            EV << "Sensor data relayed: UAV" << getIndex() << " → " << relayAddr 
+            EV << "Sensor data relayed: UAV" << nodeIndex << " → " << relayAddr 
                << " → GCS (no direct path)" << endl;
         }
+        else if (storeRecord(createLocalRecord(sensorData, sequence, attempt, timestamp))) {
+            if (attempt == 0) {
+                dataPacketsSent++;
+                emit(dataPacketsSentSignal, dataPacketsSent);
+            }
+            EV << "No path to GCS: sensor data stored (UAV" << nodeIndex << ", " << store.size() << " records)" << endl;
+        }
         else {
-            EV << "WARNING: No path to GCS for sensor data (UAV" << getIndex() << ")" << endl;
+            EV << "WARNING: No path to GCS for sensor data (UAV" << nodeIndex << ")" << endl;
+            relayFailures++;
+            emit(relayFailuresSignal, relayFailures);
         }
     }
 }
 
-void FANETApp::sendDataRelay(cPacket *originalPacket, L3Address nextHop) {
+void FANETApp::sendDataRelay(const Ptr<FanetHeader>& header, const Ptr<const FanetSensorData>& sensorData, L3Address nextHop) {
     // Incrementar contador de hops
-    int hopCount = originalPacket->par("hopCount");
-    originalPacket->par("hopCount") = hopCount + 1;
+    int hopCount = header->getHopCount() + 1;
+    header->setHopCount(hopCount);
     
     // Verificar se não excedeu limite de hops (evitar loops)
-    if (hopCount > 5) {
+    if (hopCount > maxHopCount) {
         EV << "WARNING: Max hop count exceeded, dropping packet" << endl;
-        delete originalPacket;
+        hopLimitDrops++;
+        emit(hopLimitDropsSignal, hopLimitDrops);
         return;
     }
     
-    // Reenviar pacote
+    // Este nó passa a ser o transmissor do salto; origem e sequência são preservadas
+    Coord myPos = mobility->getCurrentPosition();
+    Coord myVelocity = mobility->getCurrentVelocity();
+    header->setNodeIndex(nodeIndex);
+    header->setIsGCS(isGCS);
+    header->setPositionX(myPos.x);
+    header->setPositionY(myPos.y);
+    header->setPositionZ(myPos.z);
+    header->setVelocityX(myVelocity.x);
+    header->setVelocityY(myVelocity.y);
+    header->setVelocityZ(myVelocity.z);
+    
+    int hopsToGCS;
+    double costToGCS;
+    computeGradient(hopsToGCS, costToGCS);
+    header->setHopsToGCS(hopsToGCS);
+    header->setCostToGCS(costToGCS);
+    
+    // Reenviar pacote (o chunk de sensores é imutável e compartilhado)
     Packet *relayPacket = new Packet("FANETDataRelay");
-    relayPacket->insertAtBack(makeShared<cPacketChunk>(originalPacket));
-    socket.sendTo(relayPacket, nextHop, destPort);
+    relayPacket->insertAtBack(header);
+    relayPacket->insertAtBack(sensorData);
+    sendFANETPacket(relayPacket, nextHop);
     
-    packetsSent++;
-    emit(packetsSentSignal, packetsSent);
+    relayTransmissions++;
+    emit(relayTransmissionsSignal, relayTransmissions);
     
     EV << "Data relayed to " << nextHop << " (hop " << hopCount << ")" << endl;
 }
@@ -264,18 +614,10 @@ void FANETApp::checkConnectivity() {
     cleanExpiredNeighbors();
     
     int totalNeighbors = neighbors.size();
-    int gcsConnected = 0;
-    int uavNeighbors = 0;
-    
-    for (const auto& neighbor : neighbors) {
-        if (neighbor.second.isGCS) {
-            gcsConnected = 1;
-        } else {
-            uavNeighbors++;
-        }
-    }
+    int gcsConnected = neighbors.getNumGCS() > 0 ? 1 : 0;
+    int uavNeighbors = neighbors.getNumUAVs();
     
-    EV << "Connectivity: " << (isGCS ? "GCS" : "UAV") << " " << getIndex() 
+    EV << "Connectivity: " << (isGCS ? "GCS" : "UAV") << " " << nodeIndex 
        << " has " << totalNeighbors << " neighbors (" << uavNeighbors << " UAVs, " 
        << (gcsConnected ? "GCS connected" : "no GCS") << ")" << endl;
     
@@ -288,175 +630,1106 @@ void FANETApp::checkConnectivity() {
     }
     
     emit(neighborsFoundSignal, totalNeighbors);
+    
+    // Idade média das entradas (frescor da tabela)
+    if (!neighbors.empty()) {
+        simtime_t totalAge = 0;
+        for (const auto& neighbor : neighbors)
+            totalAge += simTime() - neighbor.lastSeen;
+        emit(neighborAgeSignal, totalAge / (double)neighbors.size());
+    }
+    
+    // Cobertura da tabela frente aos nós geometricamente no alcance
+    if (spatialGrid != nullptr) {
+        int nodesInRange = spatialGrid->countNodesInRange(mobility->getCurrentPosition(), maxTransmissionRange, getContainingNode(this));
+        double coverage = nodesInRange > 0 ? std::min(1.0, (double)totalNeighbors / nodesInRange) : 1.0;
+        EV << "  Neighbor coverage: " << totalNeighbors << "/" << nodesInRange << " nodes in range" << endl;
+        emit(neighborCoverageSignal, coverage);
+    }
 }
 
 // =============================================================================
-// PROCESSAMENTO DE MENSAGENS RECEBIDAS
+// BEACONING ADAPTATIVO (TRICKLE)
 // =============================================================================
 
-void FANETApp::processNeighborDiscovery(cPacket *packet, L3Address senderAddr) {
-    // Extrair informações de posição
-    std::string posStr = packet->par("positionInfo").stringValue();
-    std::vector<std::string> tokens;
-    std::string token;
-    std::istringstream tokenStream(posStr);
+void FANETApp::startBeaconInterval() {
+    // Novo intervalo [agora, agora + I): beacon sorteado em [I/2, I)
+    cancelEvent(neighborDiscoveryTimer);
+    cancelEvent(beaconIntervalTimer);
+    beaconsHeard = 0;
+    scheduleAt(simTime() + uniform(beaconInterval / 2, beaconInterval), neighborDiscoveryTimer);
+    scheduleAt(simTime() + beaconInterval, beaconIntervalTimer);
+    
+    emit(beaconIntervalSignal, beaconInterval);
+}
+
+void FANETApp::handleBeaconTimer() {
+    // Detecta vizinhos perdidos; se isso reiniciou o intervalo, o beacon
+    // fica para o novo intervalo (já reagendado em [Imin/2, Imin))
+    cleanExpiredNeighbors();
+    if (neighborDiscoveryTimer->isScheduled())
+        return;
+    
+    // Beacon forçado se a posição anunciada ficou velha ou antiga demais
+    Coord myPosition = mobility->getCurrentPosition();
+    bool moved = lastBeaconPosition.distance(myPosition) > beaconPositionThreshold;
+    bool overdue = simTime() - lastBeaconTime >= beaconIntervalMax;
     
-    while (std::getline(tokenStream, token, ',')) {
-        tokens.push_back(token);
+    if (beaconsHeard < beaconRedundancy || moved || overdue) {
+        sendNeighborDiscovery();
+    }
+    else {
+        beaconsSuppressed++;
+        emit(beaconsSuppressedSignal, beaconsSuppressed);
+        EV << "Beacon suppressed: " << beaconsHeard << " beacons heard in " << beaconInterval << "s interval" << endl;
     }
+}
+
+// =============================================================================
+// ESCALONAMENTO DAS TRANSMISSÕES
+// =============================================================================
+
+simtime_t FANETApp::nextTransmissionTime(simtime_t interval) {
+    if (!jitterScheduling && !slottedScheduling)
+        return simTime() + interval;
     
-    if (tokens.size() >= 4) {
-        double x = std::stod(tokens[0]);
-        double y = std::stod(tokens[1]);
-        double z = std::stod(tokens[2]);
-        bool senderIsGCS = (tokens[3] == "GCS");
-        
-        Coord senderPos(x, y, z);
-        Coord myPos = mobility->getCurrentPosition();
-        double distance = calculateDistance(myPos, senderPos);
-        
-        // Log detalhado da verificação de distância
-        EV << "Distance check: " << (isGCS ? "GCS" : "UAV") << getIndex() 
-           << " @ (" << (int)myPos.x << "," << (int)myPos.y << "," << (int)myPos.z << ")"
-           << " ← " << (senderIsGCS ? "GCS" : "UAV") << " @ (" << (int)x << "," << (int)y << "," << (int)z << ")"
-           << " = " << (int)distance << "m (max: " << (int)maxTransmissionRange << "m)" << endl;
-        
-        // Verificar se está no alcance
-        if (distance <= maxTransmissionRange) {
-            updateNeighborInfo(senderAddr, senderPos, senderIsGCS);
-            
-            // Enviar resposta
-            cPacket *response = createFANETMessage(NEIGHBOR_RESPONSE, "NEIGHBOR_RESPONSE");
-                
-                char myPosInfo[100];
-                sprintf(myPosInfo, "%.2f,%.2f,%.2f,%s", 
-                        myPos.x, myPos.y, myPos.z, isGCS ? "GCS" : "UAV");
-                response->addPar("positionInfo") = myPosInfo;
-                
-                Packet *responsePacket = new Packet("FANETResponse");
-                responsePacket->insertAtBack(makeShared<cPacketChunk>(response));
-                socket.sendTo(responsePacket, senderAddr, destPort);
-                
-                packetsSent++;
-                emit(packetsSentSignal, packetsSent);
-            
-            EV << "Discovery response: " << (isGCS ? "GCS" : "UAV") << " " << getIndex() 
-               << " → " << (senderIsGCS ? "GCS" : "UAV") << " " << senderAddr 
-               << " (dist: " << (int)distance << "m)" << endl;
-        } else {
-            EV << "Discovery ignored: " << senderAddr << " out of range (" 
-               << (int)distance << "m > " << (int)maxTransmissionRange << "m)" << endl;
+    // Períodos alinhados a múltiplos do intervalo: deslocamento sorteado a cada
+    // período (jitter) ou dentro do slot do nó (slotted)
+    simtime_t periodStart = interval * (floor(simTime() / interval) + 1);
+    if (jitterScheduling)
+        return periodStart + interval * uniform(0, txJitter);
+    return periodStart + interval * ((txSlot + uniform(0, 1)) / numTxSlots);
+}
+
+simtime_t FANETApp::firstTransmissionTime(simtime_t interval) {
+    // Primeiro período cujo deslocamento sorteado cai após o início da aplicação
+    simtime_t time = nextTransmissionTime(interval) - interval;
+    while (time < startTime)
+        time += interval;
+    return time;
+}
+
+void FANETApp::updateTxSlot() {
+    // Vizinho ouvido no próprio slot no último período: migrar para um dos
+    // slots menos ocupados (escolha distribuída, sem coordenação)
+    if (slotOccupancy[txSlot] > 0) {
+        int minOccupancy = *std::min_element(slotOccupancy.begin(), slotOccupancy.end());
+        std::vector<int> candidates;
+        for (int slot = 0; slot < numTxSlots; slot++) {
+            if (slotOccupancy[slot] == minOccupancy)
+                candidates.push_back(slot);
         }
+        int slot = candidates[intuniform(0, candidates.size() - 1)];
+        if (slot != txSlot) {
+            EV << "Tx slot " << txSlot << " shared by " << slotOccupancy[txSlot] << " neighbors, moving to slot " << slot << endl;
+            txSlot = slot;
+            slotChanges++;
+            emit(slotChangesSignal, slotChanges);
+        }
+    }
+    std::fill(slotOccupancy.begin(), slotOccupancy.end(), 0);
+}
+
+void FANETApp::recordChannelPeriod() {
+    // Fecha o trecho ocupado em andamento no fim do período
+    if (channelReceiving || channelTransmitting) {
+        channelBusyTime += simTime() - channelBusySince;
+        channelBusySince = simTime();
     }
+    
+    emit(channelBusySignal, channelBusyTime / neighborDiscoveryInterval);
+    emit(collisionsSignal, (long)periodCollisions);
+    channelBusyTime = 0;
+    periodCollisions = 0;
+}
+
+void FANETApp::resetBeaconInterval() {
+    // Vizinhança mudou: voltar ao intervalo mínimo (sem efeito se já estiver nele)
+    if (!adaptiveBeaconing || beaconInterval == 0 || beaconInterval == beaconIntervalMin)
+        return;
+    
+    EV << "Neighborhood changed: beacon interval reset to " << beaconIntervalMin << "s" << endl;
+    beaconInterval = beaconIntervalMin;
+    startBeaconInterval();
 }
 
-void FANETApp::processNeighborResponse(cPacket *packet, L3Address senderAddr) {
-    // Extrair informações de posição
-    std::string posStr = packet->par("positionInfo").stringValue();
-    std::vector<std::string> tokens;
-    std::string token;
-    std::istringstream tokenStream(posStr);
+// =============================================================================
+// PROCESSAMENTO DE MENSAGENS RECEBIDAS
+// =============================================================================
+
+void FANETApp::processNeighborDiscovery(const FANETReception& rx) {
+    bool senderIsGCS = rx.header->getIsGCS();
+    
+    // Log detalhado da verificação de distância (já validada na recepção)
+    EV << "Distance check: " << (isGCS ? "GCS" : "UAV") << nodeIndex 
+       << " @ (" << (int)rx.myPosition.x << "," << (int)rx.myPosition.y << "," << (int)rx.myPosition.z << ")"
+       << " ← " << (senderIsGCS ? "GCS" : "UAV") << " @ (" << (int)rx.senderPosition.x << "," 
+       << (int)rx.senderPosition.y << "," << (int)rx.senderPosition.z << ")"
+       << " = " << (int)rx.distance << "m (max: " << (int)maxTransmissionRange << "m)" << endl;
     
-    while (std::getline(tokenStream, token, ',')) {
-        tokens.push_back(token);
+    bool isNewNeighbor = neighbors.find(rx.senderAddress) == nullptr;
+    updateLinkEstimate(rx);
+    if (!rx.acks.empty())
+        processAcks(rx);
+    
+    // Slot do vizinho: instante do beacon dentro do período (relógios sincronizados)
+    if (slottedScheduling && !adaptiveBeaconing) {
+        double offset = fmod(rx.header->getTimestamp().dbl(), neighborDiscoveryInterval.dbl());
+        int slot = std::min(numTxSlots - 1, (int)(offset / neighborDiscoveryInterval.dbl() * numTxSlots));
+        slotOccupancy[slot]++;
     }
+    updateNeighborInfo(rx);
     
-    if (tokens.size() >= 4) {
-        double x = std::stod(tokens[0]);
-        double y = std::stod(tokens[1]);
-        double z = std::stod(tokens[2]);
-        bool senderIsGCS = (tokens[3] == "GCS");
-        
-        Coord senderPos(x, y, z);
-        Coord myPos = mobility->getCurrentPosition();
-        double distance = calculateDistance(myPos, senderPos);
-        
-        // VERIFICAÇÃO DE DISTÂNCIA TAMBÉM NO RESPONSE
-        if (distance <= maxTransmissionRange) {
-            updateNeighborInfo(senderAddr, senderPos, senderIsGCS);
-            
-            EV << "Response processed: " << (senderIsGCS ? "GCS" : "UAV") << " " << senderAddr 
-               << " added as neighbor (dist: " << (int)distance << "m)" << endl;
-        } else {
-            EV << "Response ignored: " << senderAddr << " out of range (" 
-               << (int)distance << "m > " << (int)maxTransmissionRange << "m)" << endl;
-        }
+    // Modo adaptativo: o beacon já carrega a posição, sem resposta unicast
+    if (adaptiveBeaconing) {
+        if (!isNewNeighbor)
+            beaconsHeard++;  // Beacon consistente (conta para supressão)
+        return;
     }
+    
+    // Enviar resposta
+    Packet *responsePacket = new Packet("FANETResponse");
+    responsePacket->insertAtBack(createFANETHeader(NEIGHBOR_RESPONSE));
+    sendFANETPacket(responsePacket, rx.senderAddress);
+    
+    EV << "Discovery response: " << (isGCS ? "GCS" : "UAV") << " " << nodeIndex 
+       << " → " << (senderIsGCS ? "GCS" : "UAV") << " " << rx.senderAddress 
+       << " (dist: " << (int)rx.distance << "m)" << endl;
+}
+
+void FANETApp::processNeighborResponse(const FANETReception& rx) {
+    bool senderIsGCS = rx.header->getIsGCS();
+    
+    updateNeighborInfo(rx);
+    
+    EV << "Response processed: " << (senderIsGCS ? "GCS" : "UAV") << " " << rx.senderAddress 
+       << " added as neighbor (dist: " << (int)rx.distance << "m)" << endl;
 }
 
-void FANETApp::processSensorData(cPacket *packet, L3Address senderAddr) {
+void FANETApp::processSensorData(const FANETReception& rx) {
     // Apenas GCS processa dados de sensores
     if (!isGCS) return;
     
-    std::string data = packet->par("data").stringValue();
-    int sourceUAV = packet->par("sourceUAV");
+    // Quadro agregado: cada registro é entregue individualmente
+    if (rx.header->getMessageType() == AGGREGATED_DATA) {
+        for (const auto& view : rx.records)
+            deliverRecord(view.record->getSourceNode(), view.record->getSequenceNumber(), view.record->getAttempt(),
+                          view.record->getHopCount(), view.record->getTimestamp(), view.sensorData);
+        return;
+    }
     
-    EV << "Sensor data received: UAV" << sourceUAV << " → GCS" << endl;
+    // Transmissões desde a origem (SENSOR_DATA direto = 1; relays incrementam hopCount a cada envio)
+    long hops = rx.header->getMessageType() == SENSOR_DATA ? 1 : rx.header->getHopCount();
+    deliverRecord(rx.header->getSourceNode(), rx.header->getSequenceNumber(), rx.header->getAttempt(), hops, rx.header->getTimestamp(), rx.sensorData);
+}
+
+void FANETApp::deliverRecord(int sourceNode, uint32_t sequence, uint8_t attempt, long hopCount, simtime_t timestamp, const Ptr<const FanetSensorData>& sensorData) {
+    EV << "Sensor data received: UAV" << sourceNode << " #" << sequence << " → GCS"
+       << " (T=" << sensorData->getTemperature() << "°C Bat=" << (int)sensorData->getBattery() << "%)" << endl;
     
+    // Carga da GCS conta todas as chegadas, inclusive duplicatas
     dataPacketsReceived++;
     emit(dataPacketsReceivedSignal, dataPacketsReceived);
+    recentDataPackets++;
+    
+    bool isNew = trackDelivery(sourceNode, sequence);
+    if (telemetryLog.isOpen())
+        ingestRecord(sourceNode, sequence, attempt, hopCount, timestamp, sensorData, !isNew);
+    if (!isNew)
+        return;
+    TelemetryFlow& flow = telemetryFlows[sourceNode];
+    updateAgeOfInformation(sourceNode, flow, sensorData->getSampleTime());
+    flow.latencySum += (simTime() - timestamp).dbl();
+    if (reliableTelemetry)
+        updateFlowAck(sourceNode, flow);
+    
+    // Latência desde a criação na origem (timestamp preservado pelos relays)
+    emit(dataLatencySignal, simTime() - timestamp);
+    emit(deliveredHopCountSignal, hopCount);
 }
 
-void FANETApp::processDataRelay(cPacket *packet, L3Address senderAddr) {
-    std::string finalDest = packet->par("finalDestination").stringValue();
-    int hopCount = packet->par("hopCount");
+void FANETApp::ingestRecord(int sourceNode, uint32_t sequence, uint8_t attempt, long hopCount, simtime_t timestamp, const Ptr<const FanetSensorData>& sensorData, bool duplicate) {
+    // Campos tipados copiados do chunk; o lote vai ao arquivo quando enche
+    TelemetryLogRecord record;
+    record.arrivalTime = simTime().dbl();
+    record.sampleTime = sensorData->getSampleTime().dbl();
+    record.delay = (simTime() - timestamp).dbl();
+    record.positionX = sensorData->getPositionX();
+    record.positionY = sensorData->getPositionY();
+    record.positionZ = sensorData->getPositionZ();
+    record.temperature = sensorData->getTemperature();
+    record.sequence = sequence;
+    record.sourceNode = sourceNode;
+    record.hopCount = std::min(hopCount, 255L);
+    record.attempt = attempt;
+    record.battery = (uint8_t)std::lround(std::min(std::max(sensorData->getBattery(), 0.0f), 255.0f));
+    record.flags = duplicate ? TELEMETRY_LOG_DUPLICATE : 0;
+    record.reserved = 0;
+    telemetryLog.append(record);
+}
+
+bool FANETApp::trackDelivery(int sourceNode, uint32_t sequence) {
+    TelemetryFlow& flow = telemetryFlows[sourceNode];
+    
+    if (sequence < flow.seen.size() && flow.seen[sequence]) {
+        EV << "Duplicate sensor data: UAV" << sourceNode << " #" << sequence << endl;
+        flow.duplicates++;
+        duplicateRecords++;
+        emit(duplicateRecordsSignal, duplicateRecords);
+        return false;
+    }
+    
+    if (sequence >= flow.seen.size())
+        flow.seen.resize(sequence + 1, false);
+    flow.seen[sequence] = true;
+    flow.delivered++;
+    while (flow.cumulativeAck < flow.seen.size() && flow.seen[flow.cumulativeAck])
+        flow.cumulativeAck++;
+    
+    if ((int64_t)sequence > flow.highestSequence + 1) {
+        // Amostras puladas: perdidas ou ainda em trânsito (ex.: store-and-forward)
+        flow.gaps++;
+        emit(sequenceGapSignal, (long)(sequence - flow.highestSequence - 1));
+    }
+    else if ((int64_t)sequence < flow.highestSequence) {
+        flow.reordered++;
+    }
+    flow.highestSequence = std::max(flow.highestSequence, (int64_t)sequence);
+    return true;
+}
+
+void FANETApp::updateAgeOfInformation(int sourceNode, TelemetryFlow& flow, simtime_t sampleTime) {
+    simtime_t now = simTime();
+    
+    if (flow.ageUpdates == 0) {
+        registerFlowSignals(sourceNode, flow);
+        flow.firstUpdate = now;
+    }
+    else {
+        // Amostra não mais nova que a atual (atraso/reordenação): idade não cai
+        if (sampleTime <= flow.freshestSample)
+            return;
+        
+        // Pico logo antes da queda; o vetor aoi recebe os dois vértices do dente de serra
+        simtime_t peakAge = now - flow.freshestSample;
+        flow.ageArea = flow.getAgeArea(now);
+        flow.peakAgeSum += peakAge.dbl();
+        flow.peakAgeMax = std::max(flow.peakAgeMax, peakAge.dbl());
+        emit(flow.aoiSignal, peakAge);
+        emit(flow.peakAoiSignal, peakAge);
+        emit(peakAoiSignal, peakAge);
+    }
     
-    // Verificar se é o destino final
-    if (finalDest == "GCS" && isGCS) {
+    flow.freshestSample = sampleTime;
+    flow.lastUpdate = now;
+    flow.ageUpdates++;
+    emit(flow.aoiSignal, now - sampleTime);
+}
+
+void FANETApp::registerFlowSignals(int sourceNode, TelemetryFlow& flow) {
+    // Estatísticas por UAV criadas sob demanda a partir dos @statisticTemplate
+    std::string suffix = ":uav" + std::to_string(sourceNode);
+    const char *templates[] = {"aoi", "peakAoi"};
+    simsignal_t *signals[] = {&flow.aoiSignal, &flow.peakAoiSignal};
+    
+    for (int i = 0; i < 2; i++) {
+        std::string name = templates[i] + suffix;
+        *signals[i] = registerSignal(name.c_str());
+        cProperty *statisticTemplate = getProperties()->get("statisticTemplate", templates[i]);
+        getEnvir()->addResultRecorders(this, *signals[i], name.c_str(), statisticTemplate);
+    }
+}
+
+void FANETApp::processDataRelay(const FANETReception& rx) {
+    int hopCount = rx.header->getHopCount();
+    
+    // Verificar se é o destino final (todo DATA_RELAY é destinado à GCS)
+    if (isGCS) {
         EV << "Data relay reached GCS (hop " << hopCount << ")" << endl;
-        processSensorData(packet, senderAddr);
+        processSensorData(rx);
+        return;
+    }
+    
+    // Já encaminhado (laço ou cópia por outro caminho): não gastar mais transmissões.
+    // Exceção: no modo perímetro (GPSR) a travessia da face revisita nós legitimamente
+    auto geoHeader = dynamicPtrCast<const FanetGeoHeader>(rx.header);
+    bool perimeter = geoHeader != nullptr && geoHeader->getForwardingMode() == GEO_PERIMETER;
+    if (!perimeter && isDuplicateRelay(rx.header->getSourceNode(), rx.header->getSequenceNumber(), rx.header->getAttempt(), hopCount))
+        return;
+    
+    // Agregação: reter o registro para o próximo quadro
+    if (aggregationDelay > 0) {
+        bufferRecord(createRelayRecord(*rx.header, rx.sensorData));
+        armAggregationTimer();
         return;
     }
     
     // Se não é o destino final, continuar relay
-    if (finalDest == "GCS") {
-        L3Address gcsAddr = findGCSAddress();
+    L3Address gcsAddr = findGCSAddress();
+    
+    if (!gcsAddr.isUnspecified()) {
+        // GCS encontrada diretamente
+        sendDataRelay(staticPtrCast<FanetHeader>(rx.header->dupShared()), rx.sensorData, gcsAddr);
+    } else {
+        // Tentar outro relay (geográfico: estado de roteamento viaja no cabeçalho)
+        Ptr<FanetHeader> relayHeader;
+        L3Address nextRelay;
+        if (geographicRouting && geoHeader != nullptr) {
+            auto header = staticPtrCast<FanetGeoHeader>(geoHeader->dupShared());
+            nextRelay = findGeographicNextHop(header, rx.senderAddress);
+            relayHeader = header;
+        }
+        else {
+            nextRelay = findBestRelayToGCS();
+            if (nextRelay == rx.senderAddress)
+                nextRelay = L3Address();
+            relayHeader = staticPtrCast<FanetHeader>(rx.header->dupShared());
+        }
         
-        if (!gcsAddr.isUnspecified()) {
-            // GCS encontrada diretamente
-            sendDataRelay(packet, gcsAddr);
+        if (!nextRelay.isUnspecified()) {
+            recordRelayChoice(nextRelay);
+            sendDataRelay(relayHeader, rx.sensorData, nextRelay);
+        } else if (storeRecord(createRelayRecord(*rx.header, rx.sensorData))) {
+            EV << "Relay: no path to GCS, record stored (" << store.size() << " records)" << endl;
         } else {
-            // Tentar outro relay
-            L3Address nextRelay = findBestRelayToGCS();
-            if (!nextRelay.isUnspecified() && nextRelay != senderAddr) {
-                sendDataRelay(packet, nextRelay);
-            } else {
-                EV << "WARNING: Relay failed - no path to GCS" << endl;
-            }
+            EV << "WARNING: Relay failed - no path to GCS" << endl;
+            relayFailures++;
+            emit(relayFailuresSignal, relayFailures);
         }
     }
 }
 
+void FANETApp::processAggregatedData(const FANETReception& rx) {
+    if (isGCS) {
+        EV << "Aggregated frame reached GCS (" << rx.records.size() << " records)" << endl;
+        processSensorData(rx);
+        return;
+    }
+    
+    // Relay: desagregar no próprio buffer (com agregação desligada, reenvia imediatamente)
+    for (const auto& view : rx.records) {
+        if (isDuplicateRelay(view.record->getSourceNode(), view.record->getSequenceNumber(), view.record->getAttempt(), view.record->getHopCount()))
+            continue;
+        
+        TelemetryRecord record;
+        record.sourceNode = view.record->getSourceNode();
+        record.sequenceNumber = view.record->getSequenceNumber();
+        record.hopCount = view.record->getHopCount();
+        record.attempt = view.record->getAttempt();
+        record.timestamp = view.record->getTimestamp();
+        record.bufferedAt = simTime();
+        record.sensorData = view.sensorData;
+        bufferRecord(record);
+    }
+    armAggregationTimer();
+}
+
 // =============================================================================
-// UTILITÁRIOS E GERENCIAMENTO DE VIZINHOS
+// AGREGAÇÃO EM RELAYS
 // =============================================================================
 
-L3Address FANETApp::findGCSAddress() {
+void FANETApp::bufferRecord(const TelemetryRecord& record) {
+    aggregationBuffer.push_back(record);
+    
+    // Quadro cheio: enviar sem esperar o prazo
+    if ((int)aggregationBuffer.size() >= maxAggregatedRecords)
+        flushAggregationBuffer();
+}
+
+void FANETApp::armAggregationTimer() {
+    if (aggregationBuffer.empty())
+        return;
+    
+    if (aggregationDelay <= 0)
+        flushAggregationBuffer();
+    else if (!aggregationTimer->isScheduled())
+        scheduleAt(simTime() + aggregationDelay, aggregationTimer);  // Prazo do registro mais antigo
+}
+
+void FANETApp::flushAggregationBuffer() {
+    cancelEvent(aggregationTimer);
+    if (aggregationBuffer.empty())
+        return;
+    
+    // Próximo salto comum a todos os registros: GCS direta ou relay do modo atual
+    L3Address nextHop = findGCSAddress();
+    bool direct = !nextHop.isUnspecified();
+    Ptr<FanetHeader> header;
+    if (!direct && geographicRouting && gcsPositionKnown) {
+        auto geoHeader = createGeoHeader(AGGREGATED_DATA);
+        nextHop = findGeographicNextHop(geoHeader, L3Address());
+        header = geoHeader;
+    }
+    else {
+        if (!direct)
+            nextHop = findBestRelayToGCS();
+        header = createFANETHeader(AGGREGATED_DATA);
+    }
+    
+    if (nextHop.isUnspecified()) {
+        // Sem rota: registros vão para o store-and-forward (ou são descartados)
+        int dropped = 0;
+        for (const auto& record : aggregationBuffer) {
+            if (!storeRecord(record))
+                dropped++;
+        }
+        aggregationBuffer.clear();
+        if (dropped > 0) {
+            EV << "WARNING: Aggregation flush failed - no path to GCS (" << dropped << " records dropped)" << endl;
+            relayFailures += dropped;
+            emit(relayFailuresSignal, relayFailures);
+        }
+        return;
+    }
+    if (!direct)
+        recordRelayChoice(nextHop);
+    
+    Packet *packet = new Packet("FANETAggregatedData");
+    packet->insertAtBack(header);
+    int records = 0;
+    for (const auto& record : aggregationBuffer) {
+        // Mesmo limite de saltos do relay individual
+        int hopCount = record.hopCount + 1;
+        if (hopCount > maxHopCount) {
+            EV << "WARNING: Max hop count exceeded, dropping record from UAV" << record.sourceNode << endl;
+            hopLimitDrops++;
+            emit(hopLimitDropsSignal, hopLimitDrops);
+            continue;
+        }
+        
+        auto recordHeader = recordHeaderPool.acquire();
+        recordHeader->setSourceNode(record.sourceNode);
+        recordHeader->setHopCount(hopCount);
+        recordHeader->setSequenceNumber(record.sequenceNumber);
+        recordHeader->setAttempt(record.attempt);
+        recordHeader->setTimestamp(record.timestamp);
+        packet->insertAtBack(recordHeader);
+        packet->insertAtBack(record.sensorData);
+        
+        emit(aggregationWaitSignal, simTime() - record.bufferedAt);
+        records++;
+    }
+    aggregationBuffer.clear();
+    
+    if (records == 0) {
+        delete packet;
+        return;
+    }
+    
+    sendFANETPacket(packet, nextHop);
+    
+    relayTransmissions++;
+    emit(relayTransmissionsSignal, relayTransmissions);
+    aggregatedFrames++;
+    emit(aggregatedFramesSignal, aggregatedFrames);
+    emit(recordsPerFrameSignal, (long)records);
+    
+    EV << "Aggregated frame sent to " << nextHop << " (" << records << " records)" << endl;
+}
+
+TelemetryRecord FANETApp::createLocalRecord(const Ptr<const FanetSensorData>& sensorData, uint32_t sequence, uint8_t attempt, simtime_t timestamp) {
+    TelemetryRecord record;
+    record.sourceNode = nodeIndex;
+    record.sequenceNumber = sequence;
+    record.hopCount = 0;
+    record.attempt = attempt;
+    record.timestamp = timestamp;
+    record.bufferedAt = simTime();
+    record.sensorData = sensorData;
+    return record;
+}
+
+TelemetryRecord FANETApp::createRelayRecord(const FanetHeader& header, const Ptr<const FanetSensorData>& sensorData) {
+    TelemetryRecord record;
+    record.sourceNode = header.getSourceNode();
+    record.sequenceNumber = header.getSequenceNumber();
+    record.hopCount = header.getHopCount();
+    record.attempt = header.getAttempt();
+    record.timestamp = header.getTimestamp();
+    record.bufferedAt = simTime();
+    record.sensorData = sensorData;
+    return record;
+}
+
+// =============================================================================
+// STORE-AND-FORWARD
+// =============================================================================
+
+bool FANETApp::storeRecord(const TelemetryRecord& record) {
+    if (!store.isEnabled())
+        return false;
+    
+    TelemetryRecord stored = record;
+    stored.bufferedAt = simTime();
+    int recordBytes = B(FanetRecordHeader().getChunkLength()).get() + B(record.sensorData->getChunkLength()).get();
+    int evicted = 0;
+    bool inserted = store.push(stored, recordBytes, evicted);
+    
+    if (evicted > 0) {
+        storeEvictions += evicted;
+        emit(storeEvictionsSignal, storeEvictions);
+    }
+    
+    // Recusado (menos valioso que o conteúdo): quem chamou conta como sem rota
+    if (!inserted)
+        return false;
+    storedRecords++;
+    emit(storedRecordsSignal, storedRecords);
+    emit(storeOccupancySignal, (long)store.size());
+    return true;
+}
+
+bool FANETApp::hasRouteToGCS() {
+    if (!findGCSAddress().isUnspecified() || !findBestRelayToGCS().isUnspecified())
+        return true;
+    
+    // Geográfico: qualquer vizinho pode oferecer progresso (decidido no envio)
+    return geographicRouting && gcsPositionKnown && !neighbors.empty();
+}
+
+void FANETApp::flushStore() {
+    // Rajada: todo o conteúdo sai em quadros agregados pelo caminho atual.
+    // Apenas os registros presentes agora (uma falha de envio pode devolvê-los ao store)
+    size_t pending = store.size();
+    TelemetryRecord record;
+    
+    EV << "Route to GCS available: flushing " << pending << " stored records" << endl;
+    
+    for (size_t i = 0; i < pending && store.pop(record); i++) {
+        emit(storeSojournSignal, simTime() - record.bufferedAt);
+        record.bufferedAt = simTime();
+        bufferRecord(record);
+    }
+    flushAggregationBuffer();
+    emit(storeOccupancySignal, (long)store.size());
+}
+
+// =============================================================================
+// TELEMETRIA CONFIÁVEL
+// =============================================================================
+
+void FANETApp::addPendingSample(const Ptr<const FanetSensorData>& sensorData, uint32_t sequence) {
+    // Janela cheia: a amostra mais antiga deixa de ser retransmitida
+    if ((int)retransmitWindow.size() >= retransmitWindowSize) {
+        EV << "Retransmit window full: giving up on #" << retransmitWindow.begin()->first << endl;
+        retransmitWindow.erase(retransmitWindow.begin());
+        retransmitGiveUps++;
+        emit(retransmitGiveUpsSignal, retransmitGiveUps);
+    }
+    
+    PendingSample& sample = retransmitWindow[sequence];
+    sample.sensorData = sensorData;
+    sample.timestamp = simTime();
+    sample.lastSent = simTime();
+    sample.deadline = simTime() + rto;
+    sample.transmissions = 1;
+    armRetransmitTimer();
+}
+
+void FANETApp::handleRetransmitTimer() {
+    simtime_t now = simTime();
+    
+    // Sem rota: cópias já aguardam no store/agregação; apenas adiar os prazos
+    if (!hasRouteToGCS()) {
+        for (auto& entry : retransmitWindow)
+            entry.second.deadline = std::max(entry.second.deadline, now + rto);
+        armRetransmitTimer();
+        return;
+    }
+    
+    // Karn: uma expiração dobra o RTO (até o próximo RTT válido)
+    bool expired = false;
+    for (const auto& entry : retransmitWindow)
+        expired = expired || entry.second.deadline <= now;
+    if (expired) {
+        rto = std::min(2 * rto, maxRto);
+        emit(rtoSignal, rto);
+    }
+    
+    for (auto it = retransmitWindow.begin(); it != retransmitWindow.end();) {
+        PendingSample& sample = it->second;
+        if (sample.deadline > now) {
+            ++it;
+            continue;
+        }
+        if (sample.transmissions > maxRetransmissions) {
+            EV << "No ACK for #" << it->first << " after " << sample.transmissions << " transmissions: giving up" << endl;
+            retransmitGiveUps++;
+            emit(retransmitGiveUpsSignal, retransmitGiveUps);
+            it = retransmitWindow.erase(it);
+            continue;
+        }
+        
+        EV << "Retransmitting #" << it->first << " (attempt " << sample.transmissions << ", RTO " << rto << "s)" << endl;
+        duplicateCache.checkAndInsert(nodeIndex, it->first, sample.transmissions, now);
+        transmitSample(sample.sensorData, it->first, sample.transmissions, sample.timestamp);
+        sample.transmissions++;
+        sample.lastSent = now;
+        sample.deadline = now + rto;
+        retransmissions++;
+        emit(retransmissionsSignal, retransmissions);
+        ++it;
+    }
+    armRetransmitTimer();
+}
+
+void FANETApp::armRetransmitTimer() {
+    cancelEvent(retransmitTimer);
+    if (retransmitWindow.empty())
+        return;
+    
+    simtime_t deadline = retransmitWindow.begin()->second.deadline;
+    for (const auto& entry : retransmitWindow)
+        deadline = std::min(deadline, entry.second.deadline);
+    scheduleAt(std::max(deadline, simTime()), retransmitTimer);
+}
+
+void FANETApp::processAcks(const FANETReception& rx) {
+    // Próprio: libera a janela; demais: guardados para repasse (apenas UAVs)
+    if (isGCS)
+        return;
+    
+    for (const auto& ack : rx.acks) {
+        int sourceNode = ack->getSourceNode();
+        if (sourceNode == nodeIndex) {
+            handleAck(ack->getCumulativeAck(), ack->getSackBitmap());
+            continue;
+        }
+        
+        // Estado mais novo: ACK cumulativo maior; mesmo cumulativo -> união dos SACKs
+        auto it = ackStates.find(sourceNode);
+        if (it == ackStates.end() || ack->getCumulativeAck() > it->second.cumulativeAck) {
+            AckState& state = ackStates[sourceNode];
+            state.cumulativeAck = ack->getCumulativeAck();
+            state.sackBitmap = ack->getSackBitmap();
+            state.updatedAt = simTime();
+        }
+        else if (ack->getCumulativeAck() == it->second.cumulativeAck && (ack->getSackBitmap() & ~it->second.sackBitmap) != 0) {
+            it->second.sackBitmap |= ack->getSackBitmap();
+            it->second.updatedAt = simTime();
+        }
+    }
+}
+
+void FANETApp::handleAck(uint32_t cumulativeAck, uint32_t sackBitmap) {
+    simtime_t now = simTime();
+    simtime_t rtt = -1;
+    
+    for (auto it = retransmitWindow.begin(); it != retransmitWindow.end();) {
+        uint32_t sequence = it->first;
+        bool acked = sequence < cumulativeAck ||
+            (sequence > cumulativeAck && sequence - cumulativeAck - 1 < 32 && ((sackBitmap >> (sequence - cumulativeAck - 1)) & 1));
+        if (!acked) {
+            ++it;
+            continue;
+        }
+        
+        // Karn: RTT apenas de amostras nunca retransmitidas (sem ambiguidade)
+        if (it->second.transmissions == 1)
+            rtt = std::max(rtt, now - it->second.lastSent);
+        telemetryAcked++;
+        emit(telemetryAckedSignal, telemetryAcked);
+        it = retransmitWindow.erase(it);
+    }
+    
+    if (rtt >= 0)
+        updateRto(rtt);
+    armRetransmitTimer();
+}
+
+void FANETApp::updateRto(simtime_t rtt) {
+    // Jacobson/Karels (RFC 6298): RTO = SRTT + 4 * RTTVAR
+    double sample = rtt.dbl();
+    if (!hasRttSample) {
+        srtt = sample;
+        rttvar = sample / 2;
+        hasRttSample = true;
+    }
+    else {
+        rttvar = 0.75 * rttvar + 0.25 * std::fabs(srtt - sample);
+        srtt = 0.875 * srtt + 0.125 * sample;
+    }
+    rto = std::min(maxRto, std::max(minRto, SimTime(srtt + 4 * rttvar)));
+    
+    emit(ackRttSignal, rtt);
+    emit(rtoSignal, rto);
+}
+
+void FANETApp::updateFlowAck(int sourceNode, TelemetryFlow& flow) {
+    // GCS: estado anunciado nos próximos beacons
+    AckState& state = ackStates[sourceNode];
+    state.cumulativeAck = flow.cumulativeAck;
+    state.sackBitmap = 0;
+    for (uint32_t i = 0; i < 32 && flow.cumulativeAck + 1 + i < flow.seen.size(); i++) {
+        if (flow.seen[flow.cumulativeAck + 1 + i])
+            state.sackBitmap |= 1u << i;
+    }
+    state.updatedAt = simTime();
+}
+
+void FANETApp::appendAckBlocks(Packet *packet) {
+    // Estados atualizados há menos de ackLifetime, os mais recentes primeiro
+    std::vector<std::pair<simtime_t, int>> candidates;
+    for (const auto& entry : ackStates) {
+        if (simTime() - entry.second.updatedAt <= ackLifetime)
+            candidates.push_back(std::make_pair(entry.second.updatedAt, entry.first));
+    }
+    size_t count = std::min(candidates.size(), (size_t)maxAckBlocks);
+    std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+                      [](const std::pair<simtime_t, int>& a, const std::pair<simtime_t, int>& b) { return a.first > b.first; });
+    
+    for (size_t i = 0; i < count; i++) {
+        const AckState& state = ackStates[candidates[i].second];
+        auto ack = makeShared<FanetAckBlock>();
+        ack->setSourceNode(candidates[i].second);
+        ack->setCumulativeAck(state.cumulativeAck);
+        ack->setSackBitmap(state.sackBitmap);
+        packet->insertAtBack(ack);
+    }
+    emit(ackBlocksSignal, (long)count);
+}
+
+// =============================================================================
+// ROTEAMENTO GEOGRÁFICO (GPSR)
+// =============================================================================
+
+// Cruzamento da aresta (a, b) com o segmento (c, d) no plano XY, fora do
+// próprio nó a; crossing recebe o ponto em (c, d), com Z interpolado
+static bool crossesSegment(const Coord& a, const Coord& b, const Coord& c, const Coord& d, Coord& crossing)
+{
+    double rx = b.x - a.x, ry = b.y - a.y;
+    double sx = d.x - c.x, sy = d.y - c.y;
+    double denominator = rx * sy - ry * sx;
+    if (std::fabs(denominator) < 1e-9)
+        return false;   // Paralelos
+    double t = ((c.x - a.x) * sy - (c.y - a.y) * sx) / denominator;   // Ao longo da aresta
+    double u = ((c.x - a.x) * ry - (c.y - a.y) * rx) / denominator;   // Ao longo de (c, d)
+    if (t <= 1e-9 || t > 1 || u < 0 || u > 1)
+        return false;
+    crossing = c + (d - c) * u;
+    return true;
+}
+
+void FANETApp::learnGCSPosition(const FANETReception& rx) {
+    // Com várias GCS, o destino anycast é a mais próxima conhecida: ouvida
+    // diretamente ou divulgada por um vizinho
+    Coord candidate;
+    if (rx.header->getIsGCS()) {
+        candidate = rx.senderPosition;
+    }
+    else {
+        auto geoHeader = dynamicPtrCast<const FanetGeoHeader>(rx.header);
+        if (geoHeader == nullptr)
+            return;
+        candidate = Coord(geoHeader->getDestX(), geoHeader->getDestY(), geoHeader->getDestZ());
+    }
+    
+    if (!gcsPositionKnown || rx.myPosition.distance(candidate) < rx.myPosition.distance(gcsPosition)) {
+        gcsPosition = candidate;
+        gcsPositionKnown = true;
+        EV << "GCS position learned from " << rx.senderAddress << ": " << gcsPosition << endl;
+    }
+}
+
+L3Address FANETApp::findGeographicNextHop(const Ptr<FanetGeoHeader>& header, const L3Address& previousHop) {
+    cleanExpiredNeighbors();
+    
+    Coord destination(header->getDestX(), header->getDestY(), header->getDestZ());
+    Coord myPosition = mobility->getCurrentPosition();
+    double myDistance = myPosition.distance(destination);
+    
+    // Perímetro: volta ao guloso quando este nó está mais perto que o ponto de entrada
+    if (header->getForwardingMode() == GEO_PERIMETER) {
+        Coord entry(header->getEntryX(), header->getEntryY(), header->getEntryZ());
+        if (myDistance < entry.distance(destination)) {
+            header->setForwardingMode(GEO_GREEDY);
+        }
+        else {
+            // Regra da mão direita a partir da aresta de chegada
+            const NeighborInfo *previous = neighbors.find(previousHop);
+            Coord reference = previous != nullptr ? previous->position : destination;
+            const NeighborInfo *next = findPerimeterNeighbor(myPosition, reference, L3Address());
+            
+            // Troca de face: a aresta cruza Lp -> destino mais perto do destino que
+            // Lf; segue pela próxima aresta anti-horária a partir dela (face nova)
+            Coord face(header->getFaceX(), header->getFaceY(), header->getFaceZ());
+            bool faceChanged = false;
+            Coord crossing;
+            for (int changes = 0; next != nullptr && changes < (int)neighbors.size(); changes++) {
+                if (!crossesSegment(myPosition, next->position, entry, destination, crossing) ||
+                    crossing.distance(destination) >= face.distance(destination))
+                    break;
+                face = crossing;
+                faceChanged = true;
+                next = findPerimeterNeighbor(myPosition, next->position, L3Address());
+            }
+            if (next == nullptr)
+                return L3Address();
+            
+            if (faceChanged) {
+                header->setFaceX(face.x);
+                header->setFaceY(face.y);
+                header->setFaceZ(face.z);
+                setFirstEdge(header, next);
+                EV << "Perimeter face change at UAV" << nodeIndex << ": Lf = " << face << endl;
+            }
+            else if (header->getFirstEdgeFrom() == nodeIndex && header->getFirstEdgeTo() == next->address) {
+                // e0 de novo sem troca de face: a face foi percorrida inteira,
+                // o destino é inalcançável por ela
+                perimeterLoops++;
+                emit(perimeterLoopsSignal, perimeterLoops);
+                EV << "Perimeter loop at UAV" << nodeIndex << ": first face edge revisited, destination unreachable" << endl;
+                return L3Address();
+            }
+            return next->address;
+        }
+    }
+    
+    // Guloso: vizinho com maior progresso em direção ao destino
+    const NeighborInfo *best = nullptr;
+    double bestDistance = myDistance;
     for (const auto& neighbor : neighbors) {
-        if (neighbor.second.isGCS) {
-            return neighbor.first;
+        double distance = neighbor.position.distance(destination);
+        if (distance < bestDistance) {
+            best = &neighbor;
+            bestDistance = distance;
         }
     }
-    return L3Address();  // GCS não encontrada
+    if (best != nullptr)
+        return best->address;
+    
+    // Mínimo local: entrar em modo perímetro a partir da linha até o destino
+    // (Lp = Lf = este nó; e0 = primeira aresta tomada)
+    const NeighborInfo *next = findPerimeterNeighbor(myPosition, destination, previousHop);
+    header->setForwardingMode(GEO_PERIMETER);
+    header->setEntryX(myPosition.x);
+    header->setEntryY(myPosition.y);
+    header->setEntryZ(myPosition.z);
+    header->setFaceX(myPosition.x);
+    header->setFaceY(myPosition.y);
+    header->setFaceZ(myPosition.z);
+    setFirstEdge(header, next);
+    perimeterEntries++;
+    emit(perimeterEntriesSignal, perimeterEntries);
+    
+    EV << "Greedy forwarding failed at UAV" << nodeIndex << ": entering perimeter mode" << endl;
+    return next != nullptr ? next->address : L3Address();
 }
 
-L3Address FANETApp::findBestRelayToGCS() {
-    L3Address bestRelay;
-    double minDistance = std::numeric_limits<double>::max();
+void FANETApp::setFirstEdge(const Ptr<FanetGeoHeader>& header, const NeighborInfo *next) {
+    header->setFirstEdgeFrom(nodeIndex);
+    header->setFirstEdgeTo(next != nullptr ? next->address : L3Address());
+}
+
+const NeighborInfo *FANETApp::findPerimeterNeighbor(const Coord& myPosition, const Coord& reference, const L3Address& exclude) {
+    // Primeira aresta do grafo de Gabriel no sentido anti-horário a partir da
+    // referência (projeção no plano XY)
+    double referenceAngle = atan2(reference.y - myPosition.y, reference.x - myPosition.x);
+    const NeighborInfo *next = nullptr;
+    double bestAngle = INFINITY;
     
-    // Procurar UAV mais próximo da GCS
     for (const auto& neighbor : neighbors) {
-        if (!neighbor.second.isGCS) {  // Apenas UAVs podem ser relays
-            // Aqui poderia implementar lógica mais sofisticada
-            // Por enquanto, escolher o UAV mais próximo
-            if (neighbor.second.distance < minDistance) {
-                minDistance = neighbor.second.distance;
-                bestRelay = neighbor.first;
-            }
+        if (neighbor.address == exclude || !isGabrielEdge(myPosition, neighbor))
+            continue;
+        double angle = atan2(neighbor.position.y - myPosition.y, neighbor.position.x - myPosition.x) - referenceAngle;
+        while (angle <= 0)
+            angle += 2 * M_PI;
+        while (angle > 2 * M_PI)
+            angle -= 2 * M_PI;
+        if (angle < bestAngle) {
+            next = &neighbor;
+            bestAngle = angle;
+        }
+    }
+    
+    return next;
+}
+
+bool FANETApp::isGabrielEdge(const Coord& myPosition, const NeighborInfo& neighbor) const {
+    // Aresta mantida se nenhum outro vizinho está no círculo de diâmetro (eu, vizinho)
+    double midX = (myPosition.x + neighbor.position.x) / 2;
+    double midY = (myPosition.y + neighbor.position.y) / 2;
+    double dx = neighbor.position.x - myPosition.x;
+    double dy = neighbor.position.y - myPosition.y;
+    double radiusSquared = (dx * dx + dy * dy) / 4;
+    
+    for (const auto& other : neighbors) {
+        if (other.address == neighbor.address)
+            continue;
+        double ox = other.position.x - midX;
+        double oy = other.position.y - midY;
+        if (ox * ox + oy * oy < radiusSquared)
+            return false;
+    }
+    return true;
+}
+
+// =============================================================================
+// UTILITÁRIOS E GERENCIAMENTO DE VIZINHOS
+// =============================================================================
+
+L3Address FANETApp::findGCSAddress() {
+    cleanExpiredNeighbors();
+    
+    const NeighborInfo *gcs = neighbors.getBestGCS();
+    return gcs != nullptr ? gcs->address : L3Address();  // GCS não encontrada
+}
+
+L3Address FANETApp::findBestRelayToGCS() {
+    cleanExpiredNeighbors();
+    
+    // Índice mantido pela tabela (apenas UAVs podem ser relays)
+    const NeighborInfo *relay = neighbors.getBestRelay();
+    if (relay == nullptr)
+        return L3Address();
+    
+    // Gradiente: apenas vizinhos com caminho conhecido até a GCS (descida estrita,
+    // já que o próprio gradiente é o do melhor relay + 1)
+    if (gradientRouting && relay->hopsToGCS == NeighborInfo::HOPS_UNKNOWN)
+        return L3Address();
+    
+    return relay->address;
+}
+
+void FANETApp::computeGradient(int& hopsToGCS, double& costToGCS) {
+    hopsToGCS = NeighborInfo::HOPS_UNKNOWN;
+    costToGCS = 0;
+    
+    if (isGCS) {
+        hopsToGCS = 0;
+        return;
+    }
+    
+    cleanExpiredNeighbors();
+    const NeighborInfo *gcs = neighbors.getBestGCS();
+    if (gcs != nullptr) {
+        hopsToGCS = 1;
+        costToGCS = gcs->getLinkCost();
+        return;
+    }
+    
+    // Limite evita contagem ao infinito quando a GCS some da vizinhança
+    const NeighborInfo *relay = neighbors.getBestRelay();
+    if (gradientRouting && relay != nullptr && relay->hopsToGCS < NeighborInfo::HOPS_UNKNOWN - 1) {
+        hopsToGCS = relay->hopsToGCS + 1;
+        costToGCS = relay->costToGCS + relay->getLinkCost();
+    }
+}
+
+void FANETApp::updateGCSLoad() {
+    // Taxa de chegada de dados desde a última atualização, suavizada (EWMA)
+    simtime_t elapsed = simTime() - lastLoadUpdate;
+    if (elapsed <= 0)
+        return;
+    
+    double rate = recentDataPackets / elapsed.dbl();
+    gcsLoad = lastLoadUpdate == 0 ? rate : 0.5 * gcsLoad + 0.5 * rate;
+    recentDataPackets = 0;
+    lastLoadUpdate = simTime();
+    emit(gcsLoadSignal, gcsLoad);
+}
+
+int FANETApp::deriveMaxHopCount() const {
+    // Caminho sem laços: no máximo um salto por UAV, mais o salto até a GCS
+    cModule *network = getSimulation()->getSystemModule();
+    int bound = network->hasPar("numUAVs") ? network->par("numUAVs").intValue() + 1 : 255;
+    
+    // Geográfico: o perímetro revisita nós e faz desvios maiores que a área,
+    // mas percorre cada aresta dirigida do grafo de Gabriel (planar: até
+    // 3V - 6 arestas) no máximo uma vez por face antes de o e0 encerrar o laço
+    if (geographicRouting)
+        return std::max(1, std::min(std::max(bound, 2 * (3 * bound - 6)), 255));
+    
+    // Área de voo conhecida: duas vezes a diagonal em alcances (desvios do caminho)
+    cModule *mobilityModule = check_and_cast<cModule *>(mobility);
+    if (mobilityModule->hasPar("constraintAreaMinX") && mobilityModule->hasPar("constraintAreaMaxY")) {
+        double dx = mobilityModule->par("constraintAreaMaxX").doubleValue() - mobilityModule->par("constraintAreaMinX").doubleValue();
+        double dy = mobilityModule->par("constraintAreaMaxY").doubleValue() - mobilityModule->par("constraintAreaMinY").doubleValue();
+        double dz = mobilityModule->par("constraintAreaMaxZ").doubleValue() - mobilityModule->par("constraintAreaMinZ").doubleValue();
+        if (!std::isfinite(dz))
+            dz = 0;
+        if (std::isfinite(dx) && std::isfinite(dy) && maxTransmissionRange > 0) {
+            double diagonal = sqrt(dx * dx + dy * dy + dz * dz);
+            bound = std::min(bound, (int)std::ceil(2 * diagonal / maxTransmissionRange) + 1);
         }
     }
     
-    return bestRelay;
+    // hopCount viaja em um uint8_t
+    return std::max(1, std::min(bound, 255));
+}
+
+bool FANETApp::isDuplicateRelay(int sourceNode, uint32_t sequence, uint8_t attempt, int hopCount) {
+    if (!duplicateCache.checkAndInsert(sourceNode, sequence, attempt, simTime()))
+        return false;
+    
+    // Limite superior: transmissões que a cópia ainda poderia fazer até o
+    // limite de saltos (uma cópia perto da GCS faria apenas mais uma)
+    EV << "Duplicate from UAV" << sourceNode << " seq " << sequence << " suppressed (hop " << hopCount << ")" << endl;
+    duplicatesSuppressed++;
+    emit(duplicatesSuppressedSignal, duplicatesSuppressed);
+    maxHopsSaved += std::max(0, maxHopCount - hopCount);
+    emit(maxHopsSavedSignal, maxHopsSaved);
+    return true;
+}
+
+void FANETApp::recordRelayChoice(const L3Address& relay) {
+    // Quantas escolhas divergem da heurística do UAV mais próximo
+    const NeighborInfo *nearest = neighbors.findNearestUAV();
+    if (nearest != nullptr && nearest->address != relay) {
+        relayChoiceDiffers++;
+        emit(relayChoiceDiffersSignal, relayChoiceDiffers);
+    }
+    
+    const NeighborInfo *chosen = neighbors.find(relay);
+    if (chosen != nullptr)
+        emit(relayLinkEtxSignal, chosen->etx);
+}
+
+// =============================================================================
+// ESTIMATIVA DE ENLACE (ETX)
+// =============================================================================
+
+void FANETApp::updateLinkEstimate(const FANETReception& rx) {
+    if (!linkEstimation)
+        return;
+    
+    // Beacon do vizinho: lacunas na sequência + janela de unicasts desde o último
+    LinkEstimate& link = links[rx.senderAddress];
+    int missed = link.beaconReceived(rx.header->getSequenceNumber(), linkAlpha);
+    link.foldUnicastWindow(linkAlpha);
+    
+    if (missed > 0)
+        EV << "Link " << rx.senderAddress << ": " << missed << " beacons missed" << endl;
+    
+    emit(beaconDeliveryRatioSignal, link.beaconQuality);
+    emit(linkEtxSignal, link.getEtx());
+}
+
+void FANETApp::handleLinkBroken(cObject *obj) {
+    // Quadro descartado pelo MAC após o limite de retransmissões
+    auto packet = dynamic_cast<Packet *>(obj);
+    if (packet == nullptr)
+        return;
+    const auto& networkHeader = findNetworkProtocolHeader(packet);
+    if (networkHeader == nullptr)
+        return;
+    
+    auto it = links.find(networkHeader->getDestinationAddress());
+    if (it == links.end())
+        return;
+    
+    it->second.unicastFailures++;
+    unicastFailures++;
+    emit(unicastFailuresSignal, unicastFailures);
+    EV << "Unicast to " << it->first << " failed (retry limit)" << endl;
+}
+
+double FANETApp::getLinkEtx(const L3Address& address) const {
+    if (!linkEstimation)
+        return 1;
+    
+    auto it = links.find(address);
+    return it != links.end() ? it->second.getEtx() : 1;
 }
 
 double FANETApp::calculateDistance(const Coord& pos1, const Coord& pos2) {
@@ -466,52 +1739,206 @@ double FANETApp::calculateDistance(const Coord& pos1, const Coord& pos2) {
     return sqrt(dx*dx + dy*dy + dz*dz);
 }
 
-void FANETApp::updateNeighborInfo(L3Address address, Coord position, bool neighborIsGCS) {
-    Coord myPos = mobility->getCurrentPosition();
-    double distance = calculateDistance(myPos, position);
-    
-    NeighborInfo info(address, position, simTime(), neighborIsGCS);
-    info.distance = distance;
-    
-    bool isNewNeighbor = (neighbors.find(address) == neighbors.end());
-    neighbors[address] = info;
+void FANETApp::updateNeighborInfo(const FANETReception& rx) {
+    // Estado anunciado pelo transmissor no cabeçalho
+    NeighborInfo neighbor(rx.senderAddress, rx.senderPosition, simTime(), rx.header->getIsGCS());
+    neighbor.velocity = Coord(rx.header->getVelocityX(), rx.header->getVelocityY(), rx.header->getVelocityZ());
+    neighbor.distance = rx.distance;
+    neighbor.hopsToGCS = rx.header->getHopsToGCS();
+    neighbor.costToGCS = rx.header->getCostToGCS();
+    neighbor.gcsLoad = rx.header->getGcsLoad();
+    neighbor.etx = getLinkEtx(rx.senderAddress);
+    bool isNewNeighbor = neighbors.update(neighbor);
     
     if (isNewNeighbor) {
-        EV << "New neighbor: " << (neighborIsGCS ? "GCS" : "UAV") << " " << address 
-           << " @ " << (int)distance << "m" << endl;
+        EV << "New neighbor: " << (neighbor.isGCS ? "GCS" : "UAV") << " " << rx.senderAddress 
+           << " @ " << (int)rx.distance << "m" << endl;
+        resetBeaconInterval();
     }
+    
+    // Rota nova (ou renovada): esvaziar o store-and-forward em rajada
+    if (!store.empty() && hasRouteToGCS())
+        flushStore();
 }
 
 void FANETApp::cleanExpiredNeighbors() {
-    simtime_t now = simTime();
-    auto it = neighbors.begin();
-    int removed = 0;
+    // Expiração incremental: custo O(1) quando nada expirou
+    int removed = neighbors.removeExpired(simTime());
     
-    while (it != neighbors.end()) {
-        if (now - it->second.lastSeen > neighborTimeout) {
-            it = neighbors.erase(it);
-            removed++;
-        } else {
-            ++it;
+    // Distâncias extrapoladas até agora (uma vez por instante, O(n))
+    if (deadReckoning && lastPredictionUpdate != simTime()) {
+        lastPredictionUpdate = simTime();
+        int evicted = neighbors.updatePredictions(mobility->getCurrentPosition(), simTime(), maxTransmissionRange, predictionHorizon);
+        if (evicted > 0) {
+            EV << "Evicted " << evicted << " neighbors predicted out of range" << endl;
+            predictedEvictions += evicted;
+            emit(predictedEvictionsSignal, predictedEvictions);
+            removed += evicted;
         }
     }
     
     if (removed > 0) {
         EV << "Cleaned " << removed << " expired neighbors" << endl;
+        resetBeaconInterval();
+    }
+}
+
+void FANETApp::refreshLocalAddresses() {
+    localAddresses.clear();
+    if (interfaceTable == nullptr)
+        return;
+    
+    // Inclui o loopback (127.0.0.1), que também deve ser filtrado
+    for (int i = 0; i < interfaceTable->getNumInterfaces(); i++) {
+        NetworkInterface *ie = interfaceTable->getInterface(i);
+        auto ipv4Data = ie->findProtocolData<Ipv4InterfaceData>();
+        if (ipv4Data != nullptr && !ipv4Data->getIPAddress().isUnspecified()) {
+            localAddresses.push_back(ipv4Data->getIPAddress());
+        }
+    }
+    
+    EV << "Local addresses: " << localAddresses.size() << " cached" << endl;
+}
+
+bool FANETApp::isLocalAddress(const L3Address& address) const {
+    for (const auto& localAddress : localAddresses) {
+        if (localAddress == address) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Ptr<FanetHeader> FANETApp::createFANETHeader(FANETMessageType type) {
+    // Chunk do pool do tipo: fillFANETHeader reescreve todos os campos
+    auto header = headerPools[type].acquire();
+    fillFANETHeader(header, type);
+    return header;
+}
+
+Ptr<FanetGeoHeader> FANETApp::createGeoHeader(FANETMessageType type) {
+    auto header = geoHeaderPool.acquire();
+    fillFANETHeader(header, type);
+    header->setForwardingMode(GEO_GREEDY);
+    header->setDestX(gcsPosition.x);
+    header->setDestY(gcsPosition.y);
+    header->setDestZ(gcsPosition.z);
+    return header;
+}
+
+void FANETApp::fillFANETHeader(const Ptr<FanetHeader>& header, FANETMessageType type) {
+    Coord myPos = mobility->getCurrentPosition();
+    
+    header->setMessageType(type);
+    header->setIsGCS(isGCS);
+    header->setHopCount(0);
+    header->setNodeIndex(nodeIndex);
+    header->setSourceNode(nodeIndex);
+    header->setSequenceNumber(sequenceNumber++);
+    header->setTimestamp(simTime());
+    header->setPositionX(myPos.x);
+    header->setPositionY(myPos.y);
+    header->setPositionZ(myPos.z);
+    
+    Coord myVelocity = mobility->getCurrentVelocity();
+    header->setVelocityX(myVelocity.x);
+    header->setVelocityY(myVelocity.y);
+    header->setVelocityZ(myVelocity.z);
+    
+    // Gradiente até a GCS anunciado em todas as mensagens
+    int hopsToGCS;
+    double costToGCS;
+    computeGradient(hopsToGCS, costToGCS);
+    header->setHopsToGCS(hopsToGCS);
+    header->setCostToGCS(costToGCS);
+    header->setGcsLoad(isGCS ? gcsLoad : 0);
+    header->setAttempt(0);
+}
+
+void FANETApp::sendFANETPacket(Packet *packet, const L3Address& destAddr) {
+    if (!txQueueing) {
+        transmitPacket(packet, destAddr);
+        return;
+    }
+    
+    TxClass txClass = classifyTransmission(packet);
+    if (!txScheduler.enqueue(txClass, packet, destAddr, simTime())) {
+        EV << "Tx queue full: dropping " << packet->getName() << " (" << TxScheduler::getClassName(txClass) << ")" << endl;
+        emit(txDropSignals[txClass], txScheduler.getQueue(txClass).dropped);
+        delete packet;
+        return;
+    }
+    emit(txBacklogSignal, (long)txScheduler.getLength());
+    
+    // Ocioso: entrega imediata; senão aguarda o próximo espaçamento
+    if (!txReleaseTimer->isScheduled())
+        releaseTransmission();
+}
+
+void FANETApp::transmitPacket(Packet *packet, const L3Address& destAddr) {
+    socket.sendTo(packet, destAddr, destPort);
+    
+    // Tentativa de unicast: confrontada com as falhas do MAC no próximo beacon
+    if (linkEstimation && !destAddr.isBroadcast())
+        links[destAddr].unicastAttempts++;
+    
+    packetsSent++;
+    emit(packetsSentSignal, packetsSent);
+}
+
+// =============================================================================
+// FILAS DE TRANSMISSÃO
+// =============================================================================
+
+TxClass FANETApp::classifyTransmission(const Packet *packet) const {
+    auto header = packet->peekAtFront<FanetHeader>();
+    switch (header->getMessageType()) {
+        case NEIGHBOR_DISCOVERY:
+        case NEIGHBOR_RESPONSE:
+            return TX_CONTROL;
+        case AGGREGATED_DATA:
+            return TX_RELAYED;
+        default:
+            // Retransmissões são recuperação: cedem lugar à telemetria nova
+            if (header->getAttempt() > 0)
+                return TX_BULK;
+            return header->getSourceNode() == nodeIndex ? TX_LOCAL : TX_RELAYED;
     }
 }
 
-cPacket* FANETApp::createFANETMessage(FANETMessageType type, const char* data) {
-    char msgName[50];
-    sprintf(msgName, "%s_%d", data ? data : "FANET_MSG", getIndex());
+void FANETApp::releaseTransmission() {
+    if (txScheduler.isEmpty())
+        return;
+    
+    // Fila do MAC cheia: as classes aguardam aqui, onde a política decide a ordem
+    if (macQueue != nullptr && macQueueLimit > 0 && macQueue->getNumPackets() >= macQueueLimit) {
+        scheduleAfter(txPacing, txReleaseTimer);
+        return;
+    }
     
-    cPacket *packet = new cPacket(msgName);
-    packet->addPar("messageType") = type;
-    packet->addPar("nodeIndex") = getIndex();
-    packet->addPar("timestamp") = simTime().dbl();
-    packet->setByteLength(64);  // Tamanho base do cabeçalho FANET
+    TxScheduler::Entry entry;
+    TxClass txClass = txScheduler.dequeue(entry);
+    emit(txQueueDelaySignals[txClass], simTime() - entry.enqueuedAt);
+    emit(txBacklogSignal, (long)txScheduler.getLength());
+    transmitPacket(entry.packet, entry.destAddr);
+    
+    // Espaçamento mínimo mesmo com as filas vazias (rajadas seguintes aguardam)
+    scheduleAfter(txPacing, txReleaseTimer);
+}
+
+void FANETApp::registerTxClassSignals() {
+    // txQueueDelay:<classe> / txDrops:<classe> a partir dos @statisticTemplate
+    const char *templates[] = {"txQueueDelay", "txDrops"};
+    simsignal_t *signals[] = {txQueueDelaySignals, txDropSignals};
     
-    return packet;
+    for (int c = 0; c < NUM_TX_CLASSES; c++) {
+        for (int i = 0; i < 2; i++) {
+            std::string name = std::string(templates[i]) + ":" + TxScheduler::getClassName((TxClass)c);
+            signals[i][c] = registerSignal(name.c_str());
+            cProperty *statisticTemplate = getProperties()->get("statisticTemplate", templates[i]);
+            getEnvir()->addResultRecorders(this, signals[i][c], name.c_str(), statisticTemplate);
+        }
+    }
 }
 
 // =============================================================================
@@ -526,91 +1953,113 @@ void FANETApp::socketDataArrived(UdpSocket *socket, Packet *packet) {
     auto l3AddressTag = packet->getTag<L3AddressInd>();
     L3Address senderAddress = l3AddressTag->getSrcAddress();
     
-    // FILTRAR LOOPBACK - Ignorar mensagens próprias
-    if (senderAddress.str() == "127.0.0.1" || senderAddress.str() == "localhost") {
-        EV << "DROPPED: Ignoring loopback message from " << senderAddress << endl;
+    // FILTRAR LOOPBACK E MENSAGENS PRÓPRIAS (endereços em cache)
+    if (isLocalAddress(senderAddress)) {
+        EV << "DROPPED: Ignoring own/loopback message from " << senderAddress << endl;
+        selfPacketsDropped++;
+        emit(selfPacketsDroppedSignal, selfPacketsDropped);
         delete packet;
         return;
     }
     
-    // Obter próprio endereço IP para comparação
-    L3Address myAddress = L3AddressResolver().resolve(getParentModule()->getFullPath().c_str());
-    if (senderAddress == myAddress) {
-        EV << "DROPPED: Ignoring own broadcast message from " << senderAddress << endl;
+    // Decodificar uma única vez (sem cópia do payload)
+    FANETReception rx;
+    rx.senderAddress = senderAddress;
+    if (!decodeReception(packet, rx)) {
+        EV << "Invalid packet format from " << senderAddress << endl;
         delete packet;
         return;
     }
     
-    // Extrair payload FANET para verificação prévia
-    auto chunk = packet->peekAtBack<cPacketChunk>(packet->getDataLength());
-    if (!chunk) {
-        EV << "Invalid packet format from " << senderAddress << endl;
+    // Verificação de alcance ANTES do processamento (todos os tipos de mensagem)
+    if (rx.distance > maxTransmissionRange) {
+        EV << "DROPPED: Message from " << senderAddress 
+           << " out of range (" << (int)rx.distance << "m > " 
+           << (int)maxTransmissionRange << "m)" << endl;
         delete packet;
         return;
     }
     
-    cPacket *fanetPacket = chunk->getPacket()->dup();
-    
-    // VERIFICAÇÃO PRÉVIA DE DISTÂNCIA para todos os tipos de mensagem
-    bool hasPositionInfo = fanetPacket->hasPar("positionInfo");
-    if (hasPositionInfo) {
-        std::string posStr = fanetPacket->par("positionInfo").stringValue();
-        std::vector<std::string> tokens;
-        std::string token;
-        std::istringstream tokenStream(posStr);
-        
-        while (std::getline(tokenStream, token, ',')) {
-            tokens.push_back(token);
-        }
-        
-        if (tokens.size() >= 4) {
-            double x = std::stod(tokens[0]);
-            double y = std::stod(tokens[1]);
-            double z = std::stod(tokens[2]);
-            
-            Coord senderPos(x, y, z);
-            Coord myPos = mobility->getCurrentPosition();
-            double distance = calculateDistance(myPos, senderPos);
-            
-            // Verificação de alcance ANTES do processamento
-            if (distance > maxTransmissionRange) {
-                EV << "DROPPED: Message from " << senderAddress 
-                   << " out of range (" << (int)distance << "m > " 
-                   << (int)maxTransmissionRange << "m)" << endl;
-                delete fanetPacket;
-                delete packet;
-                return;
-            }
-        }
-    }
-    
     EV << "Message received: " << packet->getName() << " from " << senderAddress << endl;
     
+    if (geographicRouting)
+        learnGCSPosition(rx);
+    
     // Processar baseado no tipo de mensagem
-    int messageType = fanetPacket->par("messageType");
+    int messageType = rx.header->getMessageType();
     
     switch (messageType) {
         case NEIGHBOR_DISCOVERY:
-            processNeighborDiscovery(fanetPacket, senderAddress);
+            processNeighborDiscovery(rx);
             break;
         case NEIGHBOR_RESPONSE:
-            processNeighborResponse(fanetPacket, senderAddress);
+            processNeighborResponse(rx);
             break;
         case SENSOR_DATA:
-            processSensorData(fanetPacket, senderAddress);
+            processSensorData(rx);
             break;
         case DATA_RELAY:
-            processDataRelay(fanetPacket, senderAddress);
+            processDataRelay(rx);
+            break;
+        case AGGREGATED_DATA:
+            processAggregatedData(rx);
             break;
         default:
             EV << "Unknown message type: " << messageType << endl;
             break;
     }
     
-    delete fanetPacket;
     delete packet;
 }
 
+bool FANETApp::decodeReception(Packet *packet, FANETReception& rx) {
+    // Chunks são apenas consultados (peek): nenhuma cópia do conteúdo
+    rx.packet = packet;
+    rx.header = packet->peekAtFront<FanetHeader>(b(-1), Chunk::PF_ALLOW_NULLPTR);
+    if (rx.header == nullptr)
+        return false;
+    
+    int messageType = rx.header->getMessageType();
+    if (messageType == SENSOR_DATA || messageType == DATA_RELAY) {
+        rx.sensorData = packet->peekAt<FanetSensorData>(rx.header->getChunkLength(), b(-1), Chunk::PF_ALLOW_NULLPTR);
+        if (rx.sensorData == nullptr)
+            return false;
+    }
+    else if (messageType == NEIGHBOR_DISCOVERY) {
+        // Estados de recepção anexados (telemetria confiável), até o fim do pacote
+        b offset = rx.header->getChunkLength();
+        while (offset < packet->getDataLength()) {
+            auto ack = packet->peekAt<FanetAckBlock>(offset, b(-1), Chunk::PF_ALLOW_NULLPTR);
+            if (ack == nullptr)
+                return false;
+            offset += ack->getChunkLength();
+            rx.acks.push_back(ack);
+        }
+    }
+    else if (messageType == AGGREGATED_DATA) {
+        // Pares (registro, leitura) até o fim do pacote
+        b offset = rx.header->getChunkLength();
+        while (offset < packet->getDataLength()) {
+            FANETRecordView view;
+            view.record = packet->peekAt<FanetRecordHeader>(offset, b(-1), Chunk::PF_ALLOW_NULLPTR);
+            if (view.record == nullptr)
+                return false;
+            offset += view.record->getChunkLength();
+            view.sensorData = packet->peekAt<FanetSensorData>(offset, b(-1), Chunk::PF_ALLOW_NULLPTR);
+            if (view.sensorData == nullptr)
+                return false;
+            offset += view.sensorData->getChunkLength();
+            rx.records.push_back(view);
+        }
+    }
+    
+    // Posição e distância calculadas uma vez para todos os handlers
+    rx.senderPosition = Coord(rx.header->getPositionX(), rx.header->getPositionY(), rx.header->getPositionZ());
+    rx.myPosition = mobility->getCurrentPosition();
+    rx.distance = calculateDistance(rx.myPosition, rx.senderPosition);
+    return true;
+}
+
 void FANETApp::socketErrorArrived(UdpSocket *socket, Indication *indication) {
     EV << "UDP socket error" << endl;
     delete indication;
@@ -620,11 +2069,208 @@ void FANETApp::socketClosed(UdpSocket *socket) {
     EV << "UDP socket closed" << endl;
 }
 
+void FANETApp::receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *details) {
+    Enter_Method("%s", cComponent::getSignalName(signalID));
+    
+    if (signalID == linkBrokenSignal) {
+        handleLinkBroken(obj);
+        return;
+    }
+    if (signalID == packetDroppedSignal) {
+        // Quadro recebido com erro (colisão/interferência); demais descartes ignorados
+        auto dropDetails = dynamic_cast<PacketDropDetails *>(details);
+        if (dropDetails != nullptr && dropDetails->getReason() == INCORRECTLY_RECEIVED)
+            periodCollisions++;
+        return;
+    }
+    
+    // Interface criada/removida ou endereço IPv4 alterado
+    refreshLocalAddresses();
+}
+
+void FANETApp::receiveSignal(cComponent *source, simsignal_t signalID, intval_t value, cObject *details) {
+    Enter_Method("%s", cComponent::getSignalName(signalID));
+    
+    // Canal ocupado: rádio ocupado/recebendo ou transmitindo
+    bool wasBusy = channelReceiving || channelTransmitting;
+    if (signalID == physicallayer::IRadio::receptionStateChangedSignal)
+        channelReceiving = value == physicallayer::IRadio::RECEPTION_STATE_BUSY || value == physicallayer::IRadio::RECEPTION_STATE_RECEIVING;
+    else if (signalID == physicallayer::IRadio::transmissionStateChangedSignal)
+        channelTransmitting = value == physicallayer::IRadio::TRANSMISSION_STATE_TRANSMITTING;
+    
+    bool busy = channelReceiving || channelTransmitting;
+    if (busy && !wasBusy)
+        channelBusySince = simTime();
+    else if (!busy && wasBusy)
+        channelBusyTime += simTime() - channelBusySince;
+}
+
 void FANETApp::finish() {
-    EV << "FANET Stats - " << (isGCS ? "GCS" : "UAV") << " " << getIndex() 
+    EV << "FANET Stats - " << (isGCS ? "GCS" : "UAV") << " " << nodeIndex 
        << ": sent=" << packetsSent << " recv=" << packetsReceived 
        << " data_sent=" << dataPacketsSent << " data_recv=" << dataPacketsReceived 
+       << " self_dropped=" << selfPacketsDropped 
+       << " beacons=" << beaconsSent << " suppressed=" << beaconsSuppressed 
+       << " relays=" << relayTransmissions << " relay_failures=" << relayFailures 
        << " neighbors=" << neighbors.size() << endl;
     
+    if (!isGCS) {
+        EV << "  Telemetry: generated=" << telemetryGenerated
+           << " drops: no_route=" << relayFailures << " hop_limit=" << hopLimitDrops
+           << " store_evicted=" << storeEvictions
+           << " duplicates_suppressed=" << duplicatesSuppressed << " max_hops_saved=" << maxHopsSaved << endl;
+        
+        // Custo da confiabilidade: retransmissões por amostra gerada
+        if (reliableTelemetry) {
+            double overhead = telemetryGenerated > 0 ? (double)retransmissions / telemetryGenerated : 0;
+            EV << "  Reliability: acked=" << telemetryAcked << " retransmissions=" << retransmissions
+               << " give_ups=" << retransmitGiveUps << " overhead=" << overhead
+               << " srtt=" << srtt << "s rto=" << rto << "s" << endl;
+            recordScalar("telemetryAcked", telemetryAcked);
+            recordScalar("retransmissionOverhead", overhead);
+            recordScalar("srtt", srtt, "s");
+            recordScalar("rto", rto.dbl(), "s");
+        }
+    }
+    
+    // Alocações de chunks por tipo de mensagem (reusos = alocações evitadas)
+    long totalAllocations = sensorDataPool.getAllocations() + recordHeaderPool.getAllocations() + geoHeaderPool.getAllocations();
+    long totalReuses = sensorDataPool.getReuses() + recordHeaderPool.getReuses();
+    cEnum *messageTypes = cEnum::get("FANETMessageType");
+    for (const auto& entry : headerPools) {
+        std::string suffix = std::string(":") + messageTypes->getStringFor(entry.first);
+        recordScalar(("headerAllocations" + suffix).c_str(), entry.second.getAllocations());
+        recordScalar(("headerReuses" + suffix).c_str(), entry.second.getReuses());
+        totalAllocations += entry.second.getAllocations();
+        totalReuses += entry.second.getReuses();
+    }
+    if (slottedScheduling)
+        recordScalar("txSlot", txSlot);
+    
+    // Filas de transmissão: volume e descartes por classe
+    if (txQueueing) {
+        EV << "  Tx queues:";
+        for (int c = 0; c < NUM_TX_CLASSES; c++) {
+            const TxScheduler::ClassQueue& queue = txScheduler.getQueue((TxClass)c);
+            std::string suffix = std::string(":") + TxScheduler::getClassName((TxClass)c);
+            EV << " " << TxScheduler::getClassName((TxClass)c) << "=" << queue.sent << "/" << queue.enqueued
+               << " (dropped " << queue.dropped << ")";
+            recordScalar(("txEnqueued" + suffix).c_str(), queue.enqueued);
+            recordScalar(("txSent" + suffix).c_str(), queue.sent);
+            recordScalar(("txDropped" + suffix).c_str(), queue.dropped);
+        }
+        EV << endl;
+    }
+    recordScalar("geoHeaderAllocations", geoHeaderPool.getAllocations());
+    recordScalar("sensorDataAllocations", sensorDataPool.getAllocations());
+    recordScalar("sensorDataReuses", sensorDataPool.getReuses());
+    recordScalar("recordHeaderAllocations", recordHeaderPool.getAllocations());
+    recordScalar("recordHeaderReuses", recordHeaderPool.getReuses());
+    EV << "  Chunks: allocated=" << totalAllocations << " reused=" << totalReuses << endl;
+    
+    // Qualidade média dos enlaces estimados (vizinhos atuais e passados)
+    if (linkEstimation && !links.empty()) {
+        double etxSum = 0;
+        for (const auto& entry : links)
+            etxSum += entry.second.getEtx();
+        EV << "  Links: estimated=" << links.size() << " mean_etx=" << etxSum / links.size()
+           << " unicast_failures=" << unicastFailures << endl;
+        recordScalar("linkEstimates", links.size());
+        recordScalar("meanLinkEtx", etxSum / links.size());
+    }
+    
+    // Recepção por origem nesta GCS (PDR em recordDeliveryRatios())
+    for (const auto& entry : telemetryFlows) {
+        const TelemetryFlow& flow = entry.second;
+        
+        EV << "  UAV" << entry.first << ": delivered=" << flow.delivered << " gaps=" << flow.gaps
+           << " duplicates=" << flow.duplicates << " reordered=" << flow.reordered << endl;
+        
+        std::string suffix = ":uav" + std::to_string(entry.first);
+        recordScalar(("flowDelivered" + suffix).c_str(), flow.delivered);
+        recordScalar(("flowDuplicates" + suffix).c_str(), flow.duplicates);
+        
+        // Goodput: leituras distintas entregues desde a primeira; latência média
+        if (flow.delivered > 0) {
+            static const b sampleLength = FanetSensorData().getChunkLength();
+            simtime_t elapsed = simTime() - flow.firstUpdate;
+            double goodput = elapsed > 0 ? flow.delivered * sampleLength.get() / elapsed.dbl() : 0;
+            recordScalar(("flowGoodput" + suffix).c_str(), goodput, "bps");
+            recordScalar(("flowLatency" + suffix).c_str(), flow.latencySum / flow.delivered, "s");
+        }
+        
+        // AoI: média temporal exata desde a primeira amostra recebida
+        if (flow.ageUpdates > 0 && simTime() > flow.firstUpdate) {
+            double meanAge = flow.getAgeArea(simTime()) / (simTime() - flow.firstUpdate).dbl();
+            double meanPeakAge = flow.ageUpdates > 1 ? flow.peakAgeSum / (flow.ageUpdates - 1) : 0;
+            EV << "    AoI: mean=" << meanAge << "s peak_mean=" << meanPeakAge << "s peak_max=" << flow.peakAgeMax
+               << "s current=" << (simTime() - flow.freshestSample) << "s" << endl;
+            recordScalar(("aoiTimeAvg" + suffix).c_str(), meanAge, "s");
+            recordScalar(("aoiCurrent" + suffix).c_str(), (simTime() - flow.freshestSample).dbl(), "s");
+        }
+    }
+    // Ingestão: lote final escrito antes do resumo
+    if (telemetryLog.isOpen()) {
+        telemetryLog.close();
+        EV << "  Telemetry log: " << telemetryLog.getRecords() << " records in " << telemetryLog.getFlushes()
+           << " batches, wall time " << telemetryLog.getWallTime() << "s (" << telemetryLog.getPath() << ")" << endl;
+        recordScalar("telemetryLogRecords", telemetryLog.getRecords());
+        recordScalar("telemetryLogFlushes", telemetryLog.getFlushes());
+        recordScalar("telemetryLogWallTime", telemetryLog.getWallTime(), "s");
+    }
+    
+    // PDR da rede: registrada uma única vez (gcs[0]) sobre todas as GCS
+    if (isGCS && nodeIndex == 0)
+        recordDeliveryRatios();
+    
     ApplicationBase::finish();
 }
+
+void FANETApp::recordDeliveryRatios() {
+    // PDR = amostras distintas entregues a qualquer GCS / amostras geradas pela
+    // origem: perdas no fim da execução e UAVs sem nenhuma entrega contam
+    cModule *network = getContainingNode(this)->getParentModule();
+    int numGCS = network->getSubmoduleVectorSize("gcs");
+    int numUAVs = network->getSubmoduleVectorSize("uav");
+    long totalDelivered = 0, totalGenerated = 0;
+    
+    for (int uav = 0; uav < numUAVs; uav++) {
+        auto source = dynamic_cast<FANETApp *>(network->getSubmodule("uav", uav)->getSubmodule("app", 0));
+        if (source == nullptr)
+            continue;
+        
+        // Toda amostra gerada consome uma sequência: seen indexado até generated
+        long generated = source->telemetryGenerated;
+        std::vector<bool> delivered(generated, false);
+        for (int gcs = 0; gcs < numGCS; gcs++) {
+            auto sink = dynamic_cast<FANETApp *>(network->getSubmodule("gcs", gcs)->getSubmodule("app", 0));
+            if (sink == nullptr)
+                continue;
+            auto it = sink->telemetryFlows.find(uav);
+            if (it == sink->telemetryFlows.end())
+                continue;
+            const std::vector<bool>& seen = it->second.seen;
+            for (size_t sequence = 0; sequence < seen.size() && sequence < delivered.size(); sequence++) {
+                if (seen[sequence])
+                    delivered[sequence] = true;
+            }
+        }
+        
+        long count = std::count(delivered.begin(), delivered.end(), true);
+        double pdr = generated > 0 ? (double)count / generated : 0;
+        totalDelivered += count;
+        totalGenerated += generated;
+        EV << "  UAV" << uav << ": pdr=" << pdr << " (" << count << "/" << generated << ", missing=" << generated - count << ")" << endl;
+        
+        std::string suffix = ":uav" + std::to_string(uav);
+        recordScalar(("flowGenerated" + suffix).c_str(), generated);
+        recordScalar(("flowMissing" + suffix).c_str(), generated - count);
+        recordScalar(("flowPdr" + suffix).c_str(), pdr);
+    }
+    
+    if (totalGenerated > 0) {
+        EV << "  Overall PDR=" << (double)totalDelivered / totalGenerated
+           << " (" << totalDelivered << "/" << totalGenerated << ", " << numUAVs << " sources)" << endl;
+        recordScalar("flowPdr", (double)totalDelivered / totalGenerated);
+    }
+}
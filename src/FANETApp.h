@@ -22,35 +22,112 @@
 #include "inet/common/packet/Packet.h"
 #include "inet/common/TagBase.h"
 #include "inet/networklayer/common/L3AddressTag_m.h"
+#include "inet/networklayer/contract/IInterfaceTable.h"
+#include "inet/physicallayer/wireless/common/contract/packetlevel/IRadio.h"
+#include "inet/queueing/contract/IPacketQueue.h"
+#include "FANETPacket_m.h"
+#include "ChunkPool.h"
+#include "DuplicateCache.h"
+#include "NeighborTable.h"
+#include "SpatialGrid.h"
+#include "TelemetryLog.h"
+#include "TelemetryStore.h"
+#include "TxScheduler.h"
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 using namespace omnetpp;
 using namespace inet;
 
 /*
- * Tipos de mensagens suportadas pelo protocolo FANET
+ * Registro de um AGGREGATED_DATA (chunks consultados, sem cópia)
  */
-enum FANETMessageType {
-    NEIGHBOR_DISCOVERY = 1,    // Descoberta de vizinhos (broadcast)
-    NEIGHBOR_RESPONSE = 2,     // Resposta à descoberta
-    SENSOR_DATA = 3,          // Dados de sensores (UAV -> GCS)
-    DATA_RELAY = 4            // Relay de dados (UAV -> UAV -> GCS)
+struct FANETRecordView {
+    Ptr<const FanetRecordHeader> record;
+    Ptr<const FanetSensorData> sensorData;
 };
 
 /*
- * Estrutura para armazenar informações dos vizinhos na rede FANET
+ * Visão decodificada de um pacote recebido
+ * 
+ * Montada uma única vez em socketDataArrived() a partir dos chunks do
+ * pacote (sem cópia) e repassada aos handlers process*().
  */
-struct NeighborInfo {
-    L3Address address;      // Endereço IP do vizinho
-    Coord position;         // Posição geográfica
-    simtime_t lastSeen;     // Última vez que foi visto
-    double distance;        // Distância calculada
-    bool isGCS;            // Se é uma Estação de Controle Terrestre
-    
-    NeighborInfo() : lastSeen(0), distance(0), isGCS(false) {}
-    NeighborInfo(L3Address addr, Coord pos, simtime_t time, bool gcs = false) 
-        : address(addr), position(pos), lastSeen(time), distance(0), isGCS(gcs) {}
+struct FANETReception {
+    Packet *packet;                            // Pacote recebido (não copiado)
+    Ptr<const FanetHeader> header;             // Cabeçalho FANET
+    Ptr<const FanetSensorData> sensorData;     // Dados de sensores (SENSOR_DATA/DATA_RELAY)
+    std::vector<FANETRecordView> records;      // Registros (AGGREGATED_DATA)
+    std::vector<Ptr<const FanetAckBlock>> acks;  // Estados de recepção anexados (beacons)
+    L3Address senderAddress;                   // Endereço do transmissor
+    Coord senderPosition;                      // Posição anunciada pelo transmissor
+    Coord myPosition;                          // Posição local na recepção
+    double distance;                           // Distância até o transmissor
+    
+    FANETReception() : packet(nullptr), distance(0) {}
+};
+
+/*
+ * Estado de entrega de um fluxo de telemetria (uma origem) na GCS
+ * 
+ * A origem numera suas amostras sem lacunas (telemetrySequence): as sequências
+ * vistas por todas as GCS, contra as amostras geradas pela origem, dão a taxa
+ * de entrega do fluxo (recordDeliveryRatios()).
+ * 
+ * Age of Information: idade(t) = t - instante da amostra mais recente já
+ * recebida. Cresce linearmente e cai a cada amostra mais nova, então a
+ * área sob a curva é acumulada exatamente (trapézios) entre atualizações.
+ */
+struct TelemetryFlow {
+    long delivered;                  // Amostras distintas entregues
+    long duplicates;                 // Cópias repetidas recebidas
+    long gaps;                       // Saltos de sequência observados
+    long reordered;                  // Amostras chegando após uma sequência maior
+    int64_t highestSequence;         // Maior sequência recebida (-1 = nenhuma)
+    std::vector<bool> seen;          // Sequências já entregues
+    uint32_t cumulativeAck;          // Próxima sequência esperada (todas as anteriores entregues)
+    double latencySum;               // Soma das latências das amostras distintas (s)
+    
+    // === AGE OF INFORMATION ===
+    simtime_t freshestSample;        // Instante da amostra mais recente recebida
+    simtime_t firstUpdate;           // Primeira amostra (início da média)
+    simtime_t lastUpdate;            // Última queda da idade
+    double ageArea;                  // Integral da idade desde firstUpdate (s²)
+    double peakAgeSum;               // Soma das idades de pico (antes de cada queda)
+    double peakAgeMax;
+    long ageUpdates;                 // Quedas da idade (amostras mais novas)
+    simsignal_t aoiSignal;           // Sinais por origem (aoi:uavN / peakAoi:uavN)
+    simsignal_t peakAoiSignal;
+    
+    TelemetryFlow() : delivered(0), duplicates(0), gaps(0), reordered(0), highestSequence(-1),
+        cumulativeAck(0), latencySum(0), ageArea(0), peakAgeSum(0), peakAgeMax(0), ageUpdates(0), aoiSignal(SIMSIGNAL_NULL), peakAoiSignal(SIMSIGNAL_NULL) {}
+    
+    // Área até 'now' incluindo o trecho aberto desde a última atualização
+    double getAgeArea(simtime_t now) const {
+        double start = (lastUpdate - freshestSample).dbl(), end = (now - freshestSample).dbl();
+        return ageArea + (start + end) / 2 * (now - lastUpdate).dbl();
+    }
+};
+
+/*
+ * Amostra própria aguardando ACK da GCS (telemetria confiável)
+ */
+struct PendingSample {
+    Ptr<const FanetSensorData> sensorData;   // Leitura (chunk imutável compartilhado)
+    simtime_t timestamp;                     // Criação (preservada nas retransmissões)
+    simtime_t lastSent;                      // Última transmissão
+    simtime_t deadline;                      // Retransmissão se sem ACK até aqui
+    int transmissions;                       // Transmissões realizadas (1 = só a original)
+};
+
+/*
+ * Estado de recepção de uma origem repassado nos beacons (telemetria confiável)
+ */
+struct AckState {
+    uint32_t cumulativeAck;          // Próxima sequência esperada
+    uint32_t sackBitmap;             // Bit i: sequência cumulativeAck + 1 + i recebida
+    simtime_t updatedAt;             // Última mudança (os mais recentes são anunciados)
 };
 
 /*
@@ -62,7 +139,7 @@ struct NeighborInfo {
  * 3. Relay de dados para nós fora de alcance
  * 4. Monitoramento de conectividade
  */
-class INET_API FANETApp : public ApplicationBase, public UdpSocket::ICallback {
+class INET_API FANETApp : public ApplicationBase, public UdpSocket::ICallback, public cListener {
 private:
     // === CONFIGURAÇÃO ===
     int localPort;                    // Porta UDP local
@@ -70,19 +147,124 @@ private:
     simtime_t startTime;              // Tempo de início da aplicação
     double neighborTimeout;           // Timeout para vizinhos (segundos)
     double maxTransmissionRange;      // Alcance máximo de transmissão (metros)
+    bool deadReckoning;               // Extrapolar vizinhos pela velocidade anunciada
+    simtime_t predictionHorizon;      // Extrapolação máxima após o último beacon
+    simtime_t lastPredictionUpdate;   // Evita extrapolar mais de uma vez por instante
     bool isGCS;                      // Se este nó é uma GCS
+    int nodeIndex;                   // Índice do nó (uav[i] / gcs)
+    int maxHopCount;                 // Limite de saltos da telemetria (derivado da topologia se < 0)
+    bool gradientRouting;            // relayMode == "gradient"
+    bool geographicRouting;          // relayMode == "geographic"
+    Coord gcsPosition;               // Posição da GCS (ouvida ou divulgada nos beacons)
+    bool gcsPositionKnown;
+    
+    // === CARGA DA GCS ===
+    double gcsLoad;                  // Taxa de dados recebidos (EWMA, pacotes/s), anunciada nos beacons
+    int recentDataPackets;           // Dados recebidos desde a última atualização da carga
+    simtime_t lastLoadUpdate;
+    
+    // === AGREGAÇÃO ===
+    simtime_t aggregationDelay;      // Retenção máxima (0 = desligado)
+    int maxAggregatedRecords;        // Registros por quadro
+    std::vector<TelemetryRecord> aggregationBuffer;
+    
+    // === INGESTÃO NA GCS ===
+    TelemetryLog telemetryLog;       // Registros recebidos em lotes no arquivo binário (opcional)
+    
+    // === STORE-AND-FORWARD ===
+    TelemetryStore store;            // Registros retidos enquanto não há rota
+    
+    // === POOL DE CHUNKS ===
+    std::map<int, ChunkPool<FanetHeader>> headerPools;   // Tipo de mensagem -> cabeçalhos
+    ChunkPool<FanetGeoHeader> geoHeaderPool;             // Apenas contagem (sem reuso: campos de perímetro)
+    ChunkPool<FanetSensorData> sensorDataPool;           // Leituras originadas
+    ChunkPool<FanetRecordHeader> recordHeaderPool;       // Registros dos quadros agregados
+    
+    // === TELEMETRIA CONFIÁVEL ===
+    bool reliableTelemetry;           // Retransmissão até o ACK da GCS
+    int retransmitWindowSize;         // Amostras aguardando ACK (mais antiga sai ao exceder)
+    int maxRetransmissions;
+    simtime_t minRto;
+    simtime_t maxRto;
+    int maxAckBlocks;                 // Estados de recepção por beacon
+    simtime_t ackLifetime;            // Estados mais antigos não são repassados
+    std::map<uint32_t, PendingSample> retransmitWindow;   // Sequência -> amostra (UAV)
+    std::map<int, AckState> ackStates;                    // Origem -> estado anunciado/repassado
+    double srtt;                      // RTT suavizado (Jacobson)
+    double rttvar;
+    simtime_t rto;                    // Timeout atual (dobrado a cada expiração, Karn)
+    bool hasRttSample;
+    
+    // === SUPRESSÃO DE DUPLICATAS ===
+    DuplicateCache duplicateCache;   // (origem, sequência) já originados/encaminhados
+    
+    // === ESTIMATIVA DE ENLACE (ETX) ===
+    bool linkEstimation;             // Ponderar relays/gradiente pelo ETX dos enlaces
+    double linkAlpha;                // Peso da amostra nova na EWMA
+    std::unordered_map<L3Address, LinkEstimate, L3AddressHash> links;  // Vizinho (atual ou passado) -> enlace
+    uint32_t beaconSequence;         // Sequência própria dos beacons (lacunas = perdas)
+    
+    uint32_t sequenceNumber;         // Sequência das mensagens de controle originadas
+    uint32_t telemetrySequence;      // Sequência densa das amostras de sensores (PDR na GCS)
+    simtime_t neighborDiscoveryInterval;   // Período da descoberta (modo fixed)
+    simtime_t dataTransmissionInterval;    // Período dos dados de sensores
+    simtime_t connectivityCheckInterval;   // Período da verificação de conectividade
+    
+    // === BEACONING ADAPTATIVO (TRICKLE) ===
+    bool adaptiveBeaconing;           // beaconingMode == "adaptive"
+    simtime_t beaconIntervalMin;      // Imin
+    simtime_t beaconIntervalMax;      // Imax
+    int beaconRedundancy;             // k
+    double beaconPositionThreshold;   // Deslocamento que força o beacon
+    simtime_t beaconInterval;         // Intervalo atual (I)
+    int beaconsHeard;                 // Beacons consistentes ouvidos no intervalo (c)
+    simtime_t lastBeaconTime;         // Último beacon transmitido
+    Coord lastBeaconPosition;         // Posição anunciada no último beacon
+    
+    // === ESCALONAMENTO DAS TRANSMISSÕES ===
+    bool jitterScheduling;            // txScheduling == "jitter"
+    bool slottedScheduling;           // txScheduling == "slotted"
+    double txJitter;                  // Deslocamento máximo (fração do período)
+    int numTxSlots;                   // Slots por período (modo slotted)
+    int txSlot;                       // Slot próprio
+    std::vector<int> slotOccupancy;   // Beacons de vizinhos ouvidos por slot no último período
+    int slotChanges;
+    
+    // === FILAS DE TRANSMISSÃO POR CLASSE ===
+    bool txQueueing;                  // txScheduler != "none"
+    TxScheduler txScheduler;          // Filas por classe (controle, relay, local, bulk)
+    simtime_t txPacing;               // Intervalo mínimo entre entregas ao socket
+    int macQueueLimit;                // Retém enquanto a fila do MAC tem tantos quadros
+    queueing::IPacketQueue *macQueue; // Fila do MAC (pilha completa; nullptr nos nós leves)
+    simsignal_t txQueueDelaySignals[NUM_TX_CLASSES];
+    simsignal_t txDropSignals[NUM_TX_CLASSES];
+    
+    // === OCUPAÇÃO DO CANAL (por período de beacon) ===
+    bool channelReceiving;            // Rádio ocupado ou recebendo
+    bool channelTransmitting;         // Rádio transmitindo
+    simtime_t channelBusySince;
+    simtime_t channelBusyTime;        // Tempo ocupado no período atual
+    int periodCollisions;             // Quadros corrompidos no período atual
     
     // === COMUNICAÇÃO ===
     UdpSocket socket;                // Socket UDP para comunicação
     IMobility *mobility;             // Interface de mobilidade
+    IInterfaceTable *interfaceTable; // Tabela de interfaces do nó
+    SpatialGrid *spatialGrid;        // Índice espacial global (opcional)
+    std::vector<L3Address> localAddresses;  // Endereços próprios (inclui loopback)
     
     // === TIMERS ===
     cMessage *neighborDiscoveryTimer;  // Timer para descoberta de vizinhos
     cMessage *dataTransmissionTimer;   // Timer para transmissão de dados
     cMessage *connectivityCheckTimer;  // Timer para verificação de conectividade
+    cMessage *beaconIntervalTimer;     // Fim do intervalo Trickle (modo adaptive)
+    cMessage *aggregationTimer;        // Envio do buffer de agregação
+    cMessage *channelStatsTimer;       // Fim do período das estatísticas do canal (pilha completa)
+    cMessage *retransmitTimer;         // Próximo prazo da janela de retransmissão
+    cMessage *txReleaseTimer;          // Próxima entrega das filas de transmissão ao socket
     
     // === GERENCIAMENTO DE VIZINHOS ===
-    std::map<L3Address, NeighborInfo> neighbors;  // Lista de vizinhos conhecidos
+    NeighborTable neighbors;         // Tabela de vizinhos conhecidos
     
     // === ESTATÍSTICAS ===
     simsignal_t packetsReceivedSignal;
@@ -90,11 +272,76 @@ private:
     simsignal_t dataPacketsReceivedSignal;
     simsignal_t dataPacketsSentSignal;
     simsignal_t neighborsFoundSignal;
+    simsignal_t selfPacketsDroppedSignal;
+    simsignal_t neighborCoverageSignal;
+    simsignal_t beaconsSentSignal;
+    simsignal_t beaconsSuppressedSignal;
+    simsignal_t beaconIntervalSignal;
+    simsignal_t neighborAgeSignal;
+    simsignal_t relayTransmissionsSignal;
+    simsignal_t relayChoiceDiffersSignal;
+    simsignal_t relayFailuresSignal;
+    simsignal_t deliveredHopCountSignal;
+    simsignal_t perimeterEntriesSignal;
+    simsignal_t perimeterLoopsSignal;
+    simsignal_t gcsLoadSignal;
+    simsignal_t dataLatencySignal;
+    simsignal_t aggregatedFramesSignal;
+    simsignal_t recordsPerFrameSignal;
+    simsignal_t aggregationWaitSignal;
+    simsignal_t hopLimitDropsSignal;
+    simsignal_t predictedEvictionsSignal;
+    simsignal_t telemetryGeneratedSignal;
+    simsignal_t duplicateRecordsSignal;
+    simsignal_t sequenceGapSignal;
+    simsignal_t peakAoiSignal;
+    simsignal_t storeOccupancySignal;
+    simsignal_t storeSojournSignal;
+    simsignal_t storeEvictionsSignal;
+    simsignal_t storedRecordsSignal;
+    simsignal_t linkEtxSignal;
+    simsignal_t beaconDeliveryRatioSignal;
+    simsignal_t unicastFailuresSignal;
+    simsignal_t relayLinkEtxSignal;
+    simsignal_t duplicatesSuppressedSignal;
+    simsignal_t slotChangesSignal;
+    simsignal_t retransmissionsSignal;
+    simsignal_t retransmitGiveUpsSignal;
+    simsignal_t telemetryAckedSignal;
+    simsignal_t ackRttSignal;
+    simsignal_t rtoSignal;
+    simsignal_t ackBlocksSignal;
+    simsignal_t channelBusySignal;
+    simsignal_t collisionsSignal;
+    simsignal_t maxHopsSavedSignal;
+    simsignal_t txBacklogSignal;
     
     int packetsReceived;
     int packetsSent;
     int dataPacketsReceived;
     int dataPacketsSent;
+    int selfPacketsDropped;
+    int beaconsSent;
+    int beaconsSuppressed;
+    int relayTransmissions;
+    int relayChoiceDiffers;
+    int relayFailures;
+    int hopLimitDrops;
+    int predictedEvictions;
+    int telemetryGenerated;
+    int duplicateRecords;
+    std::map<int, TelemetryFlow> telemetryFlows;   // Origem -> fluxo (apenas GCS)
+    int perimeterEntries;
+    int perimeterLoops;
+    int aggregatedFrames;
+    int storeEvictions;
+    int storedRecords;
+    int unicastFailures;
+    int duplicatesSuppressed;
+    int retransmissions;
+    int retransmitGiveUps;
+    int telemetryAcked;
+    long maxHopsSaved;
 
 protected:
     // === LIFECYCLE ===
@@ -108,24 +355,94 @@ protected:
     virtual void scheduleTimers();
     
     // === PROCESSAMENTO DE MENSAGENS ===
-    virtual void processNeighborDiscovery(cPacket *packet, L3Address senderAddr);
-    virtual void processNeighborResponse(cPacket *packet, L3Address senderAddr);
-    virtual void processSensorData(cPacket *packet, L3Address senderAddr);
-    virtual void processDataRelay(cPacket *packet, L3Address senderAddr);
+    virtual bool decodeReception(Packet *packet, FANETReception& rx);
+    virtual void processNeighborDiscovery(const FANETReception& rx);
+    virtual void processNeighborResponse(const FANETReception& rx);
+    virtual void processSensorData(const FANETReception& rx);
+    virtual void processDataRelay(const FANETReception& rx);
+    virtual void processAggregatedData(const FANETReception& rx);
+    virtual void deliverRecord(int sourceNode, uint32_t sequence, uint8_t attempt, long hopCount, simtime_t timestamp, const Ptr<const FanetSensorData>& sensorData);
+    virtual void ingestRecord(int sourceNode, uint32_t sequence, uint8_t attempt, long hopCount, simtime_t timestamp, const Ptr<const FanetSensorData>& sensorData, bool duplicate);
+    virtual bool trackDelivery(int sourceNode, uint32_t sequence);
+    virtual void recordDeliveryRatios();
+    virtual void updateAgeOfInformation(int sourceNode, TelemetryFlow& flow, simtime_t sampleTime);
+    virtual void registerFlowSignals(int sourceNode, TelemetryFlow& flow);
     
     // === FUNCIONALIDADES CORE FANET ===
     virtual void sendNeighborDiscovery();
     virtual void sendSensorData();
-    virtual void sendDataRelay(cPacket *originalPacket, L3Address nextHop);
+    virtual void transmitSample(const Ptr<const FanetSensorData>& sensorData, uint32_t sequence, uint8_t attempt, simtime_t timestamp);
+    virtual void sendDataRelay(const Ptr<FanetHeader>& header, const Ptr<const FanetSensorData>& sensorData, L3Address nextHop);
     virtual void checkConnectivity();
     
+    // === AGREGAÇÃO EM RELAYS ===
+    virtual void bufferRecord(const TelemetryRecord& record);
+    virtual void armAggregationTimer();
+    virtual void flushAggregationBuffer();
+    virtual TelemetryRecord createLocalRecord(const Ptr<const FanetSensorData>& sensorData, uint32_t sequence, uint8_t attempt, simtime_t timestamp);
+    virtual TelemetryRecord createRelayRecord(const FanetHeader& header, const Ptr<const FanetSensorData>& sensorData);
+    
+    // === STORE-AND-FORWARD ===
+    virtual bool storeRecord(const TelemetryRecord& record);
+    virtual bool hasRouteToGCS();
+    virtual void flushStore();
+    
+    // === TELEMETRIA CONFIÁVEL ===
+    virtual void addPendingSample(const Ptr<const FanetSensorData>& sensorData, uint32_t sequence);
+    virtual void handleRetransmitTimer();
+    virtual void armRetransmitTimer();
+    virtual void processAcks(const FANETReception& rx);
+    virtual void handleAck(uint32_t cumulativeAck, uint32_t sackBitmap);
+    virtual void updateRto(simtime_t rtt);
+    virtual void updateFlowAck(int sourceNode, TelemetryFlow& flow);
+    virtual void appendAckBlocks(Packet *packet);
+    
+    // === ESCALONAMENTO ===
+    virtual simtime_t nextTransmissionTime(simtime_t interval);
+    virtual simtime_t firstTransmissionTime(simtime_t interval);
+    virtual void updateTxSlot();
+    virtual void recordChannelPeriod();
+    
+    // === BEACONING ADAPTATIVO ===
+    virtual void startBeaconInterval();
+    virtual void handleBeaconTimer();
+    virtual void resetBeaconInterval();
+    
     // === UTILITÁRIOS ===
     virtual L3Address findGCSAddress();
     virtual L3Address findBestRelayToGCS();
+    virtual void computeGradient(int& hopsToGCS, double& costToGCS);
+    virtual void recordRelayChoice(const L3Address& relay);
+    virtual void updateGCSLoad();
+    virtual int deriveMaxHopCount() const;
+    virtual bool isDuplicateRelay(int sourceNode, uint32_t sequence, uint8_t attempt, int hopCount);
+    
+    // === ESTIMATIVA DE ENLACE ===
+    virtual void updateLinkEstimate(const FANETReception& rx);
+    virtual void handleLinkBroken(cObject *obj);
+    double getLinkEtx(const L3Address& address) const;
+    
+    // === ROTEAMENTO GEOGRÁFICO (GPSR) ===
+    virtual void learnGCSPosition(const FANETReception& rx);
+    virtual L3Address findGeographicNextHop(const Ptr<FanetGeoHeader>& header, const L3Address& previousHop);
+    virtual const NeighborInfo *findPerimeterNeighbor(const Coord& myPosition, const Coord& reference, const L3Address& exclude);
+    virtual void setFirstEdge(const Ptr<FanetGeoHeader>& header, const NeighborInfo *next);
+    virtual bool isGabrielEdge(const Coord& myPosition, const NeighborInfo& neighbor) const;
     virtual double calculateDistance(const Coord& pos1, const Coord& pos2);
-    virtual void updateNeighborInfo(L3Address address, Coord position, bool isGCS = false);
+    virtual void updateNeighborInfo(const FANETReception& rx);
     virtual void cleanExpiredNeighbors();
-    virtual cPacket* createFANETMessage(FANETMessageType type, const char* data = nullptr);
+    virtual void refreshLocalAddresses();
+    virtual bool isLocalAddress(const L3Address& address) const;
+    virtual Ptr<FanetHeader> createFANETHeader(FANETMessageType type);
+    virtual Ptr<FanetGeoHeader> createGeoHeader(FANETMessageType type);
+    virtual void fillFANETHeader(const Ptr<FanetHeader>& header, FANETMessageType type);
+    virtual void sendFANETPacket(Packet *packet, const L3Address& destAddr);
+    virtual void transmitPacket(Packet *packet, const L3Address& destAddr);
+    
+    // === FILAS DE TRANSMISSÃO ===
+    virtual TxClass classifyTransmission(const Packet *packet) const;
+    virtual void releaseTransmission();
+    virtual void registerTxClassSignals();
     
     // === LIFECYCLE INET 4.5.4 ===
     virtual bool isInitializeStage(int stage) const override { return stage == INITSTAGE_APPLICATION_LAYER; }
@@ -140,6 +457,10 @@ protected:
     virtual void socketDataArrived(UdpSocket *socket, Packet *packet) override;
     virtual void socketErrorArrived(UdpSocket *socket, Indication *indication) override;
     virtual void socketClosed(UdpSocket *socket) override;
+    
+    // === LISTENER (mudanças de interface) ===
+    virtual void receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *details) override;
+    virtual void receiveSignal(cComponent *source, simsignal_t signalID, intval_t value, cObject *details) override;
 
 public:
     FANETApp() {}
@@ -0,0 +1,323 @@
+/*
+ * FanetNeighborCache.cc
+ *
+ * Implementação do cache de vizinhos do meio de rádio da FANET
+ */
+
+#include "FanetNeighborCache.h"
+#include "SpatialGrid.h"
+#include "inet/common/ModuleAccess.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace omnetpp;
+using namespace inet;
+using namespace inet::physicallayer;
+
+Define_Module(FanetNeighborCache);
+
+FanetNeighborCache::~FanetNeighborCache()
+{
+    cancelAndDelete(refillTimer);
+}
+
+void FanetNeighborCache::initialize(int stage)
+{
+    if (stage == INITSTAGE_LOCAL) {
+        radioMedium = getModuleFromPar<RadioMedium>(par("radioMediumModule"), this);
+        cellSize = par("cellSize");
+        maxSpeed = par("maxSpeed");
+        refillPeriod = par("refillPeriod");
+        if (cellSize <= 0)
+            throw cRuntimeError("cellSize must be positive");
+
+        // Valores negativos: derivados dos módulos de mobilidade em addRadio()
+        autoMaxSpeed = maxSpeed < 0;
+        autoRefillPeriod = refillPeriod < 0;
+        if (autoMaxSpeed)
+            maxSpeed = 0;
+        if (autoRefillPeriod)
+            refillPeriod = 0;
+
+        fanOutSignal = registerSignal("fanOut");
+        candidatesSignal = registerSignal("candidates");
+        refillTimer = new cMessage("refillTimer");
+    }
+    else if (stage == INITSTAGE_LAST) {
+        // Nenhuma mobilidade com os parâmetros: limites do meio / 1s
+        if (autoMaxSpeed && maxSpeed == 0)
+            maxSpeed = radioMedium->getMediumLimitCache()->getMaxSpeed().get();
+        if (autoRefillPeriod && refillPeriod == 0)
+            refillPeriod = 1;
+
+        if (refillPeriod > 0 && !entries.empty())
+            scheduleAt(simTime() + refillPeriod, refillTimer);
+
+        EV << "FanetNeighborCache: " << entries.size() << " radios in " << cells.size()
+           << " cells, maxSpeed " << maxSpeed << "mps, refill " << refillPeriod
+           << "s, margin " << maxSpeed * refillPeriod.dbl() << "m" << endl;
+    }
+}
+
+void FanetNeighborCache::handleMessage(cMessage *msg)
+{
+    if (msg == refillTimer) {
+        refillStaleEntries();
+        scheduleAt(simTime() + refillPeriod, refillTimer);
+    }
+    else
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+}
+
+void FanetNeighborCache::receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *details)
+{
+    Enter_Method("%s", cComponent::getSignalName(signalID));
+
+    if (signalID != IMobility::mobilityStateChangedSignal || updating)
+        return;
+
+    auto it = radiosByMobility.find(source->getId());
+    if (it == radiosByMobility.end())
+        return;
+
+    // Atualização incremental: apenas os rádios desta mobilidade
+    for (const IRadio *radio : it->second)
+        updateEntry(entryByRadio[radio]);
+    numSignalUpdates++;
+}
+
+// =============================================================================
+// REGISTRO DE RÁDIOS
+// =============================================================================
+
+void FanetNeighborCache::addRadio(const IRadio *radio)
+{
+    Enter_Method("addRadio");
+
+    IMobility *mobility = radio->getAntenna()->getMobility();
+    cModule *mobilityModule = check_and_cast<cModule *>(mobility);
+    deriveMobilityParameters(mobilityModule);
+
+    std::vector<const IRadio *>& radios = radiosByMobility[mobilityModule->getId()];
+    if (radios.empty())
+        mobilityModule->subscribe(IMobility::mobilityStateChangedSignal, this);
+    radios.push_back(radio);
+
+    RadioEntry entry;
+    entry.radio = radio;
+    entry.mobility = mobility;
+    entry.cellKey = 0;
+    entry.slotInCell = 0;
+    entryByRadio[radio] = entries.size();
+    entries.push_back(entry);
+
+    // Leitura inicial e inserção na célula
+    size_t index = entries.size() - 1;
+    updating = true;
+    entries[index].position = mobility->getCurrentPosition();
+    entries[index].velocity = mobility->getCurrentVelocity();
+    updating = false;
+    entries[index].updateTime = simTime();
+    entries[index].cellKey = getCellKey(entries[index].position);
+    std::vector<size_t>& cell = cells[entries[index].cellKey];
+    entries[index].slotInCell = cell.size();
+    cell.push_back(index);
+}
+
+void FanetNeighborCache::removeRadio(const IRadio *radio)
+{
+    Enter_Method("removeRadio");
+
+    auto it = entryByRadio.find(radio);
+    if (it == entryByRadio.end())
+        return;
+    size_t index = it->second;
+    removeFromCell(index);
+    entryByRadio.erase(it);
+
+    cModule *mobilityModule = check_and_cast<cModule *>(entries[index].mobility);
+    std::vector<const IRadio *>& radios = radiosByMobility[mobilityModule->getId()];
+    radios.erase(std::find(radios.begin(), radios.end(), radio));
+    if (radios.empty()) {
+        radiosByMobility.erase(mobilityModule->getId());
+        mobilityModule->unsubscribe(IMobility::mobilityStateChangedSignal, this);
+    }
+
+    // Preencher o buraco com o último elemento (mantém contiguidade)
+    size_t last = entries.size() - 1;
+    if (index != last) {
+        entries[index] = entries[last];
+        entryByRadio[entries[index].radio] = index;
+        cells[entries[index].cellKey][entries[index].slotInCell] = index;
+    }
+    entries.pop_back();
+}
+
+void FanetNeighborCache::deriveMobilityParameters(cModule *mobilityModule)
+{
+    // ArbitraryMobility/SwarmMobility: maxSpeed do próprio nó
+    if (autoMaxSpeed && mobilityModule->hasPar("maxSpeed"))
+        maxSpeed = std::max(maxSpeed, mobilityModule->par("maxSpeed").doubleValue());
+    if (!autoRefillPeriod)
+        return;
+
+    // Passo real da mobilidade: SwarmMobility -> passo do controlador do enxame;
+    // ArbitraryMobility orientado a eventos não tem passo (sinal a cada mudança)
+    simtime_t step = 0;
+    if (mobilityModule->hasPar("controllerModule")) {
+        cModule *controller = findModuleFromPar<cModule>(mobilityModule->par("controllerModule"), mobilityModule);
+        if (controller != nullptr && controller->hasPar("updateInterval"))
+            step = controller->par("updateInterval").doubleValue();
+    }
+    else if (mobilityModule->hasPar("updateInterval")) {
+        bool eventDriven = mobilityModule->hasPar("eventDriven") && mobilityModule->par("eventDriven").boolValue();
+        if (!eventDriven)
+            step = mobilityModule->par("updateInterval").doubleValue();
+    }
+    refillPeriod = std::max(refillPeriod, step);
+}
+
+// =============================================================================
+// ATUALIZAÇÃO DA GRADE
+// =============================================================================
+
+void FanetNeighborCache::updateEntry(size_t index)
+{
+    RadioEntry& entry = entries[index];
+
+    // A leitura pode reemitir mobilityStateChanged: ignorado durante a leitura
+    updating = true;
+    entry.position = entry.mobility->getCurrentPosition();
+    entry.velocity = entry.mobility->getCurrentVelocity();
+    updating = false;
+    entry.updateTime = simTime();
+
+    int64_t cellKey = getCellKey(entry.position);
+    if (cellKey != entry.cellKey)
+        moveToCell(index, cellKey);
+}
+
+void FanetNeighborCache::refillStaleEntries()
+{
+    // Sem sinal há um período inteiro: reler a mobilidade (ex.: SwarmMobility
+    // sem sinais). Demais: apenas reposicionar pela posição extrapolada, de
+    // modo que a célula nunca esteja mais de refillPeriod desatualizada
+    simtime_t now = simTime();
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (now - entries[i].updateTime >= refillPeriod) {
+            updateEntry(i);
+            numRefills++;
+        }
+        else {
+            int64_t cellKey = getCellKey(predictPosition(entries[i], now));
+            if (cellKey != entries[i].cellKey)
+                moveToCell(i, cellKey);
+        }
+    }
+}
+
+void FanetNeighborCache::removeFromCell(size_t index)
+{
+    RadioEntry& entry = entries[index];
+
+    // Remoção O(1) da célula (troca com o último)
+    std::vector<size_t>& cell = cells[entry.cellKey];
+    size_t moved = cell.back();
+    cell[entry.slotInCell] = moved;
+    entries[moved].slotInCell = entry.slotInCell;
+    cell.pop_back();
+    if (cell.empty())
+        cells.erase(entry.cellKey);
+}
+
+void FanetNeighborCache::moveToCell(size_t index, int64_t cellKey)
+{
+    removeFromCell(index);
+
+    RadioEntry& entry = entries[index];
+    std::vector<size_t>& cell = cells[cellKey];
+    entry.cellKey = cellKey;
+    entry.slotInCell = cell.size();
+    cell.push_back(index);
+}
+
+int64_t FanetNeighborCache::getCellKey(const Coord& position) const
+{
+    return SpatialGrid::makeCellKey(cellCoordinate(position.x), cellCoordinate(position.y), cellCoordinate(position.z));
+}
+
+// =============================================================================
+// CONSULTA
+// =============================================================================
+
+void FanetNeighborCache::sendToNeighbors(IRadio *transmitter, const IWirelessSignal *signal, double range) const
+{
+    auto start = std::chrono::steady_clock::now();
+    simtime_t now = simTime();
+    Coord center = transmitter->getAntenna()->getMobility()->getCurrentPosition();
+
+    // Margem das células: deslocamento máximo desde o último reposicionamento
+    double reach = range + maxSpeed * refillPeriod.dbl();
+    int minX = cellCoordinate(center.x - reach), maxX = cellCoordinate(center.x + reach);
+    int minY = cellCoordinate(center.y - reach), maxY = cellCoordinate(center.y + reach);
+    int minZ = cellCoordinate(center.z - reach), maxZ = cellCoordinate(center.z + reach);
+
+    // Receptores coletados antes do envio: sendToRadio lê as mobilidades, o que
+    // pode disparar mobilityStateChanged e mover entradas entre células
+    long candidates = 0;
+    receivers.clear();
+    for (int x = minX; x <= maxX; x++) {
+        for (int y = minY; y <= maxY; y++) {
+            for (int z = minZ; z <= maxZ; z++) {
+                auto it = cells.find(SpatialGrid::makeCellKey(x, y, z));
+                if (it == cells.end())
+                    continue;
+                for (size_t index : it->second) {
+                    const RadioEntry& entry = entries[index];
+                    if (entry.radio == transmitter)
+                        continue;
+                    candidates++;
+
+                    // Folga apenas para desvios da extrapolação (mobilidade sem sinal)
+                    double slack = 2 * maxSpeed * (now - entry.updateTime).dbl();
+                    Coord delta = predictPosition(entry, now) - center;
+                    double limit = range + slack;
+                    if (delta.x * delta.x + delta.y * delta.y + delta.z * delta.z <= limit * limit)
+                        receivers.push_back(entry.radio);
+                }
+            }
+        }
+    }
+
+    for (const IRadio *receiver : receivers)
+        radioMedium->sendToRadio(transmitter, receiver, signal);
+
+    // A interface declara a consulta const; estatísticas são do módulo
+    auto self = const_cast<FanetNeighborCache *>(this);
+    self->numFrames++;
+    self->queryWallTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    self->emit(fanOutSignal, (long)receivers.size());
+    self->emit(candidatesSignal, candidates);
+}
+
+std::ostream& FanetNeighborCache::printToStream(std::ostream& stream, int level, int evFlags) const
+{
+    stream << "FanetNeighborCache";
+    if (level <= PRINT_LEVEL_TRACE)
+        stream << EV_FIELD(cellSize) << EV_FIELD(maxSpeed) << EV_FIELD(refillPeriod);
+    return stream;
+}
+
+void FanetNeighborCache::finish()
+{
+    EV << "FanetNeighborCache: " << numFrames << " frames, " << numSignalUpdates << " signal updates, "
+       << numRefills << " refills, query wall time " << queryWallTime << "s" << endl;
+
+    recordScalar("numRadios", entries.size());
+    recordScalar("numFrames", numFrames);
+    recordScalar("numSignalUpdates", numSignalUpdates);
+    recordScalar("numRefills", numRefills);
+    recordScalar("queryWallTime", queryWallTime, "s");
+    recordScalar("maxSpeed", maxSpeed, "mps");
+    recordScalar("refillPeriod", refillPeriod.dbl(), "s");
+}
@@ -0,0 +1,99 @@
+/*
+ * FanetNeighborCache.h
+ *
+ * Cache de vizinhos do meio de rádio ajustado à mobilidade da FANET
+ *
+ * Grade 3D de rádios atualizada incrementalmente pelo sinal
+ * mobilityStateChanged de cada mobilidade (sem reconstruções completas).
+ * Entre sinais a posição é extrapolada pela velocidade, exata para o
+ * movimento retilíneo por trechos do ArbitraryMobility. Velocidade máxima e
+ * período de revalidação vêm dos parâmetros de mobilidade dos nós (passo do
+ * controlador do enxame para SwarmMobility).
+ */
+
+#ifndef FANETNEIGHBORCACHE_H_
+#define FANETNEIGHBORCACHE_H_
+
+#include "inet/common/INETDefs.h"
+#include "inet/common/geometry/common/Coord.h"
+#include "inet/mobility/contract/IMobility.h"
+#include "inet/physicallayer/wireless/common/contract/packetlevel/INeighborCache.h"
+#include "inet/physicallayer/wireless/common/medium/RadioMedium.h"
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+using namespace omnetpp;
+using namespace inet;
+using namespace inet::physicallayer;
+
+class INET_API FanetNeighborCache : public cSimpleModule, public INeighborCache, public cListener {
+  protected:
+    // Estado de um rádio: posição/velocidade do último sinal de mobilidade
+    struct RadioEntry {
+        const IRadio *radio;
+        IMobility *mobility;
+        Coord position;
+        Coord velocity;
+        simtime_t updateTime;
+        int64_t cellKey;
+        size_t slotInCell;
+    };
+
+    // === CONFIGURAÇÃO ===
+    RadioMedium *radioMedium;
+    double cellSize;             // Aresta da célula (>= alcance de comunicação)
+    double maxSpeed;             // Maior velocidade dos nós (parâmetro ou derivada da mobilidade)
+    simtime_t refillPeriod;      // Revalidação de entradas sem sinal recente
+    bool autoMaxSpeed;
+    bool autoRefillPeriod;
+
+    // === ESTADO ===
+    std::vector<RadioEntry> entries;                                // Armazenamento contíguo
+    std::unordered_map<const IRadio *, size_t> entryByRadio;        // Rádio -> entrada
+    std::unordered_map<int, std::vector<const IRadio *>> radiosByMobility;  // Id da mobilidade -> rádios
+    std::unordered_map<int64_t, std::vector<size_t>> cells;         // Célula -> entradas
+    mutable std::vector<const IRadio *> receivers;                  // Resultado reutilizado das consultas
+    cMessage *refillTimer;
+    bool updating;
+
+    // === ESTATÍSTICAS ===
+    simsignal_t fanOutSignal;
+    simsignal_t candidatesSignal;
+    long numFrames;
+    long numSignalUpdates;
+    long numRefills;
+    double queryWallTime;        // Tempo real gasto em sendToNeighbors (s)
+
+  protected:
+    virtual void initialize(int stage) override;
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void handleMessage(cMessage *msg) override;
+    virtual void finish() override;
+    virtual void receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *details) override;
+
+    virtual void deriveMobilityParameters(cModule *mobilityModule);
+    virtual void refillStaleEntries();
+    void updateEntry(size_t index);
+    void moveToCell(size_t index, int64_t cellKey);
+    void removeFromCell(size_t index);
+    int cellCoordinate(double value) const { return (int)std::floor(value / cellSize); }
+    int64_t getCellKey(const Coord& position) const;
+    Coord predictPosition(const RadioEntry& entry, simtime_t now) const {
+        return entry.position + entry.velocity * (now - entry.updateTime).dbl();
+    }
+
+  public:
+    FanetNeighborCache() : radioMedium(nullptr), refillTimer(nullptr), updating(false),
+        numFrames(0), numSignalUpdates(0), numRefills(0), queryWallTime(0) {}
+    virtual ~FanetNeighborCache();
+
+    // === INeighborCache ===
+    virtual void addRadio(const IRadio *radio) override;
+    virtual void removeRadio(const IRadio *radio) override;
+    virtual void sendToNeighbors(IRadio *transmitter, const IWirelessSignal *signal, double range) const override;
+
+    virtual std::ostream& printToStream(std::ostream& stream, int level, int evFlags = 0) const override;
+};
+
+#endif /* FANETNEIGHBORCACHE_H_ */
@@ -0,0 +1,17 @@
+/*
+ * MobilityBounds.h
+ *
+ * Constantes de contenção compartilhadas pelas mobilidades dos UAVs
+ *
+ * ArbitraryMobility (modos periódico e analítico) e SwarmMobilityController
+ * rebatem nos limites da área recuando a mesma margem, para que todos os
+ * modelos cubram a mesma região.
+ */
+
+#ifndef MOBILITYBOUNDS_H_
+#define MOBILITYBOUNDS_H_
+
+// Margem da rebatida (m) para evitar oscilação na borda
+const double BOUNDARY_MARGIN = 1.0;
+
+#endif /* MOBILITYBOUNDS_H_ */
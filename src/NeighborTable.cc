@@ -0,0 +1,256 @@
+/*
+ * NeighborTable.cc
+ *
+ * Implementação da tabela de vizinhos da aplicação FANET
+ */
+
+#include "NeighborTable.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+using namespace omnetpp;
+using namespace inet;
+
+size_t L3AddressHash::operator()(const L3Address& address) const {
+    switch (address.getType()) {
+        case L3Address::IPv4:
+            return std::hash<uint32_t>()(address.toIpv4().getInt());
+        case L3Address::MAC:
+            return std::hash<uint64_t>()(address.toMac().getInt());
+        default:
+            return std::hash<std::string>()(address.str());
+    }
+}
+
+// =============================================================================
+// ESTIMATIVA DE ENLACE
+// =============================================================================
+
+int LinkEstimate::beaconReceived(uint32_t sequence, double alpha) {
+    // Primeiro beacon (ou sequência reiniciada/lacuna implausível): só sincroniza
+    uint32_t gap = sequence - lastBeaconSequence;
+    bool resync = !hasBeaconSamples || gap == 0 || gap > (uint32_t)MAX_BEACON_GAP;
+    lastBeaconSequence = sequence;
+    hasBeaconSamples = true;
+    if (resync) {
+        beaconQuality = (1 - alpha) * beaconQuality + alpha;
+        return 0;
+    }
+    
+    // gap - 1 amostras 0 seguidas de uma amostra 1
+    int missed = gap - 1;
+    beaconQuality = beaconQuality * std::pow(1 - alpha, gap) + alpha;
+    return missed;
+}
+
+void LinkEstimate::foldUnicastWindow(double alpha) {
+    if (unicastAttempts == 0)
+        return;
+    
+    double success = std::max(0, unicastAttempts - unicastFailures) / (double)unicastAttempts;
+    unicastQuality = hasUnicastSamples ? (1 - alpha) * unicastQuality + alpha * success : success;
+    hasUnicastSamples = true;
+    unicastAttempts = 0;
+    unicastFailures = 0;
+}
+
+double LinkEstimate::getEtx() const {
+    // Enlace reverso pelos beacons; ida pelos unicasts (ou simetria)
+    double quality = beaconQuality * (hasUnicastSamples ? unicastQuality : beaconQuality);
+    return 1 / std::max(MIN_QUALITY, quality);
+}
+
+// =============================================================================
+// ATUALIZAÇÃO E REMOÇÃO
+// =============================================================================
+
+bool NeighborTable::update(const NeighborInfo& neighbor) {
+    auto it = indexByAddress.find(neighbor.address);
+    bool isNew = (it == indexByAddress.end());
+    size_t index;
+
+    if (isNew) {
+        index = entries.size();
+        entries.push_back(neighbor);
+        generations.push_back(nextGeneration);
+        indexByAddress[neighbor.address] = index;
+        expiryQueue.push(ExpiryEntry{neighbor.lastSeen + timeout, neighbor.address, nextGeneration++});
+        if (neighbor.isGCS)
+            numGCS++;
+    }
+    else {
+        index = it->second;
+        if (entries[index].isGCS != neighbor.isGCS) {
+            // Mudança de papel: índices precisam ser reconstruídos
+            numGCS += neighbor.isGCS ? 1 : -1;
+            entries[index] = neighbor;
+            recomputeBestGCS();
+            recomputeBestRelay();
+            return false;
+        }
+    }
+
+    NeighborInfo previous = entries[index];
+    NeighborInfo& info = entries[index];
+    info = neighbor;
+
+    // Manter índices: melhora -> O(1); piora do atual melhor -> nova varredura
+    int& bestIndex = info.isGCS ? bestGCS : bestRelay;
+    if (bestIndex == (int)index) {
+        if (!isNew && isBetter(previous, info)) {
+            if (info.isGCS)
+                recomputeBestGCS();
+            else
+                recomputeBestRelay();
+        }
+    }
+    else if (bestIndex < 0 || isBetter(info, entries[bestIndex])) {
+        bestIndex = index;
+    }
+
+    return isNew;
+}
+
+bool NeighborTable::remove(const L3Address& address) {
+    auto it = indexByAddress.find(address);
+    if (it == indexByAddress.end())
+        return false;
+
+    removeAt(it->second);
+    return true;
+}
+
+void NeighborTable::removeAt(size_t index) {
+    bool wasGCS = entries[index].isGCS;
+    bool wasBest = (int)index == bestGCS || (int)index == bestRelay;
+    size_t last = entries.size() - 1;
+
+    indexByAddress.erase(entries[index].address);
+    if (index != last) {
+        // Preencher o buraco com o último elemento (mantém contiguidade)
+        entries[index] = entries[last];
+        generations[index] = generations[last];
+        indexByAddress[entries[index].address] = index;
+        if (bestGCS == (int)last)
+            bestGCS = index;
+        if (bestRelay == (int)last)
+            bestRelay = index;
+    }
+    entries.pop_back();
+    generations.pop_back();
+
+    if (wasGCS)
+        numGCS--;
+    if (wasBest) {
+        if (wasGCS)
+            recomputeBestGCS();
+        else
+            recomputeBestRelay();
+    }
+}
+
+int NeighborTable::removeExpired(simtime_t now) {
+    int removed = 0;
+
+    // Apenas o topo do heap é examinado enquanto nada expirou
+    while (!expiryQueue.empty() && expiryQueue.top().expiryTime < now) {
+        ExpiryEntry entry = expiryQueue.top();
+        expiryQueue.pop();
+
+        // Já removido explicitamente (e talvez reinserido, com nova entrada)
+        auto it = indexByAddress.find(entry.address);
+        if (it == indexByAddress.end() || generations[it->second] != entry.generation)
+            continue;
+
+        simtime_t expiryTime = entries[it->second].lastSeen + timeout;
+        if (expiryTime < now) {
+            removeAt(it->second);
+            removed++;
+        }
+        else {
+            // Visto novamente desde a inserção: rearmar com o prazo atual
+            expiryQueue.push(ExpiryEntry{expiryTime, entry.address, entry.generation});
+        }
+    }
+
+    return removed;
+}
+
+int NeighborTable::updatePredictions(const Coord& myPosition, simtime_t now, double range, simtime_t horizon) {
+    int removed = 0;
+
+    // De trás para frente: removeAt() move o último elemento para o buraco
+    for (size_t i = entries.size(); i-- > 0;) {
+        NeighborInfo& entry = entries[i];
+        simtime_t until = std::min(now, entry.lastSeen + horizon);
+        if (until > entry.positionTime) {
+            entry.position += entry.velocity * (until - entry.positionTime).dbl();
+            entry.positionTime = until;
+        }
+        entry.distance = myPosition.distance(entry.position);
+        if (entry.distance > range) {
+            removeAt(i);
+            removed++;
+        }
+    }
+
+    // Distâncias mudaram: critérios dos índices também
+    recomputeBestGCS();
+    recomputeBestRelay();
+    return removed;
+}
+
+// =============================================================================
+// CONSULTAS E ÍNDICES
+// =============================================================================
+
+const NeighborInfo *NeighborTable::find(const L3Address& address) const {
+    auto it = indexByAddress.find(address);
+    return it == indexByAddress.end() ? nullptr : &entries[it->second];
+}
+
+const NeighborInfo *NeighborTable::findNearestUAV() const {
+    const NeighborInfo *nearest = nullptr;
+    for (const auto& entry : entries) {
+        if (!entry.isGCS && (nearest == nullptr || entry.distance < nearest->distance))
+            nearest = &entry;
+    }
+    return nearest;
+}
+
+bool NeighborTable::isBetterRelay(const NeighborInfo& candidate, const NeighborInfo& current) const {
+    if (relayMetric == RELAY_GRADIENT) {
+        // Gradiente: menos saltos; empate -> menor custo total passando pelo vizinho
+        if (candidate.hopsToGCS != current.hopsToGCS)
+            return candidate.hopsToGCS < current.hopsToGCS;
+        return candidate.costToGCS + candidate.getLinkCost() < current.costToGCS + current.getLinkCost();
+    }
+    
+    // UAV mais próximo (ponderado pelo ETX do enlace)
+    return candidate.getLinkCost() < current.getLinkCost();
+}
+
+bool NeighborTable::isBetterGCS(const NeighborInfo& candidate, const NeighborInfo& current) const {
+    if (gcsMetric == GCS_LEAST_LOADED && candidate.gcsLoad != current.gcsLoad)
+        return candidate.gcsLoad < current.gcsLoad;
+    
+    // GCS mais próxima (ponderada pelo ETX do enlace)
+    return candidate.getLinkCost() < current.getLinkCost();
+}
+
+void NeighborTable::recomputeBestGCS() {
+    bestGCS = -1;
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].isGCS && (bestGCS < 0 || isBetterGCS(entries[i], entries[bestGCS])))
+            bestGCS = i;
+    }
+}
+
+void NeighborTable::recomputeBestRelay() {
+    bestRelay = -1;
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (!entries[i].isGCS && (bestRelay < 0 || isBetterRelay(entries[i], entries[bestRelay])))
+            bestRelay = i;
+    }
+}
@@ -0,0 +1,187 @@
+/*
+ * NeighborTable.h
+ *
+ * Tabela de vizinhos da aplicação FANET
+ *
+ * - Armazenamento contíguo (std::vector) com índice hash por endereço
+ * - Índices mantidos para a melhor GCS e para o melhor relay,
+ *   atualizados a cada inserção/atualização (consulta O(1))
+ * - Expiração incremental via min-heap ordenado por lastSeen + timeout
+ */
+
+#ifndef NEIGHBORTABLE_H_
+#define NEIGHBORTABLE_H_
+
+#include "inet/common/INETDefs.h"
+#include "inet/common/geometry/common/Coord.h"
+#include "inet/networklayer/common/L3Address.h"
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+using namespace omnetpp;
+using namespace inet;
+
+/*
+ * Estrutura para armazenar informações dos vizinhos na rede FANET
+ */
+struct NeighborInfo {
+    L3Address address;      // Endereço IP do vizinho
+    Coord position;         // Posição geográfica (anunciada ou extrapolada até positionTime)
+    Coord velocity;         // Velocidade anunciada
+    simtime_t positionTime; // Instante a que position se refere
+    simtime_t lastSeen;     // Última vez que foi visto
+    double distance;        // Distância calculada (atualizada pela extrapolação)
+    bool isGCS;            // Se é uma Estação de Controle Terrestre
+    int hopsToGCS;         // Saltos anunciados até a GCS mais próxima
+    double costToGCS;      // Custo anunciado até a GCS (soma dos custos dos enlaces)
+    double gcsLoad;        // Carga anunciada pela GCS (pacotes de dados/s)
+    double etx;            // Transmissões esperadas no enlace (1 = sem perdas)
+
+    static const int HOPS_UNKNOWN = 255;
+
+    NeighborInfo() : positionTime(0), lastSeen(0), distance(0), isGCS(false), hopsToGCS(HOPS_UNKNOWN), costToGCS(0), gcsLoad(0), etx(1) {}
+    NeighborInfo(L3Address addr, Coord pos, simtime_t time, bool gcs = false)
+        : address(addr), position(pos), positionTime(time), lastSeen(time), distance(0), isGCS(gcs), hopsToGCS(gcs ? 0 : HOPS_UNKNOWN), costToGCS(0), gcsLoad(0), etx(1) {}
+
+    // Custo do enlace: distância ponderada pelo ETX (metros equivalentes)
+    double getLinkCost() const { return distance * etx; }
+};
+
+/*
+ * Estimativa de qualidade do enlace com um vizinho (EWMA)
+ *
+ * - beaconQuality: fração de beacons do vizinho recebidos, pelas lacunas na
+ *   sequência dos beacons (enlace reverso)
+ * - unicastQuality: fração de unicasts ao vizinho sem falha do MAC (limite de
+ *   retransmissões), que já inclui ida e ACK
+ *
+ * ETX = 1 / (beaconQuality * unicastQuality); sem unicasts ainda, o enlace é
+ * suposto simétrico (1 / beaconQuality^2). Mantida fora da tabela de vizinhos
+ * para sobreviver à expiração e reentrada do vizinho.
+ */
+struct LinkEstimate {
+    double beaconQuality;
+    double unicastQuality;
+    bool hasUnicastSamples;
+    bool hasBeaconSamples;
+    uint32_t lastBeaconSequence;
+    int unicastAttempts;     // Janela desde a última atualização
+    int unicastFailures;
+
+    static constexpr double MIN_QUALITY = 0.05;  // ETX máximo de 20
+    static const int MAX_BEACON_GAP = 64;        // Lacunas maiores: vizinho reiniciou/reentrou
+
+    LinkEstimate() : beaconQuality(1), unicastQuality(1), hasUnicastSamples(false), hasBeaconSamples(false),
+        lastBeaconSequence(0), unicastAttempts(0), unicastFailures(0) {}
+
+    // Beacon recebido: cada beacon perdido desde o anterior é uma amostra 0;
+    // retorna quantos foram perdidos
+    int beaconReceived(uint32_t sequence, double alpha);
+
+    // Incorpora a janela de unicasts (tentativas/falhas) como uma amostra
+    void foldUnicastWindow(double alpha);
+
+    double getEtx() const;
+};
+
+/*
+ * Hash de L3Address para o índice da tabela
+ */
+struct L3AddressHash {
+    size_t operator()(const L3Address& address) const;
+};
+
+class NeighborTable {
+  public:
+    typedef std::vector<NeighborInfo>::const_iterator const_iterator;
+
+    // Critério do melhor relay UAV
+    enum RelayMetric {
+        RELAY_NEAREST,     // UAV mais próximo
+        RELAY_GRADIENT     // Menos saltos até a GCS, depois menor custo (via o vizinho)
+    };
+
+    // Critério da melhor GCS (destino anycast)
+    enum GCSMetric {
+        GCS_NEAREST,       // GCS mais próxima
+        GCS_LEAST_LOADED   // Menor carga anunciada; empate -> mais próxima
+    };
+
+  private:
+    // Entrada do heap de expiração: uma por vizinho, rearmada ao expirar
+    // se o vizinho foi visto novamente desde a inserção. A geração identifica
+    // a inserção: entradas de um vizinho removido (e talvez reinserido) são
+    // descartadas ao chegar ao topo
+    struct ExpiryEntry {
+        simtime_t expiryTime;
+        L3Address address;
+        uint64_t generation;
+        bool operator>(const ExpiryEntry& other) const { return expiryTime > other.expiryTime; }
+    };
+
+    std::vector<NeighborInfo> entries;                                   // Armazenamento contíguo
+    std::vector<uint64_t> generations;                                   // Geração de cada entrada (paralelo a entries)
+    uint64_t nextGeneration;
+    std::unordered_map<L3Address, size_t, L3AddressHash> indexByAddress;  // Endereço -> posição em entries
+    std::priority_queue<ExpiryEntry, std::vector<ExpiryEntry>, std::greater<ExpiryEntry>> expiryQueue;
+
+    simtime_t timeout;       // Timeout de vizinhos
+    int bestGCS;             // Índice da melhor GCS (-1 se nenhuma)
+    int bestRelay;           // Índice do melhor relay UAV (-1 se nenhum)
+    int numGCS;              // Quantidade de GCS na tabela
+    RelayMetric relayMetric; // Critério do índice bestRelay
+    GCSMetric gcsMetric;     // Critério do índice bestGCS
+
+  protected:
+    virtual bool isBetterRelay(const NeighborInfo& candidate, const NeighborInfo& current) const;
+    virtual bool isBetterGCS(const NeighborInfo& candidate, const NeighborInfo& current) const;
+    bool isBetter(const NeighborInfo& candidate, const NeighborInfo& current) const {
+        return candidate.isGCS ? isBetterGCS(candidate, current) : isBetterRelay(candidate, current);
+    }
+    void recomputeBestGCS();
+    void recomputeBestRelay();
+    void removeAt(size_t index);
+
+  public:
+    NeighborTable() : nextGeneration(0), timeout(30), bestGCS(-1), bestRelay(-1), numGCS(0), relayMetric(RELAY_NEAREST), gcsMetric(GCS_NEAREST) {}
+    virtual ~NeighborTable() {}
+
+    void setTimeout(simtime_t timeout) { this->timeout = timeout; }
+    simtime_t getTimeout() const { return timeout; }
+    void setRelayMetric(RelayMetric metric) { relayMetric = metric; recomputeBestRelay(); }
+    RelayMetric getRelayMetric() const { return relayMetric; }
+    void setGCSMetric(GCSMetric metric) { gcsMetric = metric; recomputeBestGCS(); }
+    GCSMetric getGCSMetric() const { return gcsMetric; }
+
+    // Insere ou atualiza um vizinho com o estado anunciado (lastSeen = instante
+    // da recepção); retorna true se for novo
+    bool update(const NeighborInfo& neighbor);
+    bool remove(const L3Address& address);
+
+    // Remove vizinhos não vistos há mais de timeout; retorna quantos saíram
+    int removeExpired(simtime_t now);
+
+    // Extrapola posição/distância de todos os vizinhos até 'now' (no máximo
+    // horizon após o último beacon) e remove os previstos fora de range;
+    // retorna quantos saíram. Índices de melhor GCS/relay são recalculados
+    int updatePredictions(const Coord& myPosition, simtime_t now, double range, simtime_t horizon);
+
+    // === CONSULTAS O(1) ===
+    const NeighborInfo *find(const L3Address& address) const;
+    const NeighborInfo *getBestGCS() const { return bestGCS < 0 ? nullptr : &entries[bestGCS]; }
+    const NeighborInfo *getBestRelay() const { return bestRelay < 0 ? nullptr : &entries[bestRelay]; }
+
+    // UAV mais próximo independente do critério (O(n), para comparação)
+    const NeighborInfo *findNearestUAV() const;
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    int getNumGCS() const { return numGCS; }
+    int getNumUAVs() const { return (int)entries.size() - numGCS; }
+
+    const_iterator begin() const { return entries.begin(); }
+    const_iterator end() const { return entries.end(); }
+};
+
+#endif /* NEIGHBORTABLE_H_ */
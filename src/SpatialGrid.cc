@@ -0,0 +1,227 @@
+/*
+ * SpatialGrid.cc
+ *
+ * Implementação do índice espacial global da rede FANET
+ */
+
+#include "SpatialGrid.h"
+#include "inet/common/ModuleAccess.h"
+
+using namespace omnetpp;
+using namespace inet;
+
+Define_Module(SpatialGrid);
+
+SpatialGrid::~SpatialGrid()
+{
+    cancelAndDelete(refreshTimer);
+}
+
+void SpatialGrid::initialize(int stage)
+{
+    if (stage == INITSTAGE_LOCAL) {
+        cellSize = par("cellSize");
+        maxSpeed = par("maxSpeed");
+        refreshInterval = par("refreshInterval");
+        if (cellSize <= 0)
+            throw cRuntimeError("cellSize must be positive");
+
+        refreshTimer = new cMessage("refreshTimer");
+
+        // Todos os módulos de mobilidade emitem para cima até a rede
+        getSystemModule()->subscribe(IMobility::mobilityStateChangedSignal, this);
+    }
+    else if (stage == INITSTAGE_LAST) {
+        // Garante o registro de nós que não emitiram sinal na inicialização
+        registerNodes();
+
+        if (refreshInterval > 0)
+            scheduleAt(simTime() + refreshInterval, refreshTimer);
+
+        EV << "SpatialGrid: " << nodes.size() << " nodes in " << cells.size()
+           << " cells (cell size " << cellSize << "m)" << endl;
+    }
+}
+
+void SpatialGrid::handleMessage(cMessage *msg)
+{
+    if (msg == refreshTimer) {
+        refreshAll();
+        scheduleAt(simTime() + refreshInterval, refreshTimer);
+    }
+    else
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+}
+
+void SpatialGrid::receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *details)
+{
+    Enter_Method("%s", cComponent::getSignalName(signalID));
+
+    if (signalID == IMobility::mobilityStateChangedSignal && !updating)
+        updateNode(check_and_cast<IMobility *>(source));
+}
+
+// =============================================================================
+// ATUALIZAÇÃO DA GRADE
+// =============================================================================
+
+void SpatialGrid::registerNodes()
+{
+    for (cModule::SubmoduleIterator it(getSystemModule()); !it.end(); ++it) {
+        cModule *node = *it;
+        if (!isNetworkNode(node))
+            continue;
+        IMobility *mobility = dynamic_cast<IMobility *>(node->getSubmodule("mobility"));
+        if (mobility != nullptr)
+            updateNode(mobility);
+    }
+}
+
+void SpatialGrid::updateNode(IMobility *mobility)
+{
+    cModule *mobilityModule = check_and_cast<cModule *>(mobility);
+    auto it = nodeByMobilityId.find(mobilityModule->getId());
+    if (it != nodeByMobilityId.end()) {
+        updateEntry(it->second);
+        return;
+    }
+
+    // Apenas a mobilidade principal do nó (ignora antenas/mobilidades anexas)
+    cModule *node = findContainingNode(mobilityModule);
+    if (node == nullptr || node->getSubmodule("mobility") != mobilityModule)
+        return;
+
+    NodeEntry entry;
+    entry.node = node;
+    entry.mobility = mobility;
+    // Nós parados (ex.: GCS com StationaryMobility) não emitem sinal nem limitam a margem
+    entry.moving = mobility->getMaxSpeed() != 0;
+    entry.updateOrderIt = entry.moving ? updateOrder.insert(updateOrder.end(), nodes.size()) : updateOrder.end();
+    readState(entry);
+    entry.cellKey = getCellKey(entry.position);
+
+    std::vector<size_t>& cell = cells[entry.cellKey];
+    entry.slotInCell = cell.size();
+    cell.push_back(nodes.size());
+    nodeByMobilityId[mobilityModule->getId()] = nodes.size();
+    nodes.push_back(entry);
+}
+
+void SpatialGrid::updateEntry(size_t index)
+{
+    NodeEntry& entry = nodes[index];
+    readState(entry);
+
+    int64_t cellKey = getCellKey(entry.position);
+    if (cellKey != entry.cellKey)
+        moveToCell(index, cellKey);
+}
+
+void SpatialGrid::readState(NodeEntry& entry)
+{
+    // A leitura pode reemitir mobilityStateChanged: ignorado durante a leitura
+    updating = true;
+    entry.position = entry.mobility->getCurrentPosition();
+    entry.velocity = entry.mobility->getCurrentVelocity();
+    updating = false;
+    entry.updateTime = simTime();
+    
+    // Atualizações em tempo não decrescente: o fim da lista é a mais recente
+    if (entry.moving)
+        updateOrder.splice(updateOrder.end(), updateOrder, entry.updateOrderIt);
+}
+
+void SpatialGrid::moveToCell(size_t index, int64_t cellKey)
+{
+    NodeEntry& entry = nodes[index];
+
+    // Remoção O(1) da célula antiga (troca com o último)
+    std::vector<size_t>& oldCell = cells[entry.cellKey];
+    size_t moved = oldCell.back();
+    oldCell[entry.slotInCell] = moved;
+    nodes[moved].slotInCell = entry.slotInCell;
+    oldCell.pop_back();
+    if (oldCell.empty())
+        cells.erase(entry.cellKey);
+
+    std::vector<size_t>& newCell = cells[cellKey];
+    entry.cellKey = cellKey;
+    entry.slotInCell = newCell.size();
+    newCell.push_back(index);
+}
+
+void SpatialGrid::refreshAll()
+{
+    // Revalida todos os baldes com as posições atuais (O(N) por intervalo)
+    for (size_t i = 0; i < nodes.size(); i++)
+        updateEntry(i);
+}
+
+// =============================================================================
+// CONSULTAS
+// =============================================================================
+
+int64_t SpatialGrid::getCellKey(const Coord& position) const
+{
+    return makeCellKey(cellCoordinate(position.x), cellCoordinate(position.y), cellCoordinate(position.z));
+}
+
+int64_t SpatialGrid::makeCellKey(int x, int y, int z)
+{
+    // 21 bits por eixo (com sinal) em uma chave de 64 bits
+    const int64_t mask = ((int64_t)1 << 21) - 1;
+    return (((int64_t)x & mask) << 42) | (((int64_t)y & mask) << 21) | ((int64_t)z & mask);
+}
+
+Coord SpatialGrid::predictPosition(const NodeEntry& entry, simtime_t now) const
+{
+    // Movimento linear desde a última atualização (sem reentrar na mobilidade)
+    return entry.position + entry.velocity * (now - entry.updateTime).dbl();
+}
+
+double SpatialGrid::getSearchMargin(simtime_t now) const
+{
+    // Margem cobre nós que saíram da célula desde a sua última atualização:
+    // a entrada móvel mais antiga limita o deslocamento de todas (nós parados
+    // não contam; nós móveis sem sinal, ex. SwarmMobility sem emitSignals, só
+    // são reposicionados pelo refreshInterval)
+    if (updateOrder.empty())
+        return 0;
+    return maxSpeed * (now - nodes[updateOrder.front()].updateTime).dbl();
+}
+
+void SpatialGrid::getNodesInRange(const Coord& center, double range, std::vector<cModule *>& result, const cModule *exclude) const
+{
+    simtime_t now = simTime();
+    double rangeSquared = range * range;
+
+    double reach = range + getSearchMargin(now);
+    int minX = cellCoordinate(center.x - reach), maxX = cellCoordinate(center.x + reach);
+    int minY = cellCoordinate(center.y - reach), maxY = cellCoordinate(center.y + reach);
+    int minZ = cellCoordinate(center.z - reach), maxZ = cellCoordinate(center.z + reach);
+
+    for (int x = minX; x <= maxX; x++) {
+        for (int y = minY; y <= maxY; y++) {
+            for (int z = minZ; z <= maxZ; z++) {
+                auto it = cells.find(makeCellKey(x, y, z));
+                if (it == cells.end())
+                    continue;
+                for (size_t index : it->second) {
+                    const NodeEntry& entry = nodes[index];
+                    if (entry.node == exclude)
+                        continue;
+                    Coord delta = predictPosition(entry, now) - center;
+                    if (delta.x * delta.x + delta.y * delta.y + delta.z * delta.z <= rangeSquared)
+                        result.push_back(entry.node);
+                }
+            }
+        }
+    }
+}
+
+int SpatialGrid::countNodesInRange(const Coord& center, double range, const cModule *exclude) const
+{
+    std::vector<cModule *> result;
+    getNodesInRange(center, range, result, exclude);
+    return result.size();
+}
@@ -0,0 +1,87 @@
+/*
+ * SpatialGrid.h
+ *
+ * Índice espacial global das posições dos nós da rede FANET
+ *
+ * Grade 3D uniforme (células do tamanho do maior alcance) alimentada pelo
+ * sinal mobilityStateChanged de cada nó. Consultas por alcance retornam os
+ * nós dentro do raio em O(k), examinando apenas as células vizinhas.
+ */
+
+#ifndef SPATIALGRID_H_
+#define SPATIALGRID_H_
+
+#include "inet/common/INETDefs.h"
+#include "inet/common/geometry/common/Coord.h"
+#include "inet/mobility/contract/IMobility.h"
+#include <cmath>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+using namespace omnetpp;
+using namespace inet;
+
+class INET_API SpatialGrid : public cSimpleModule, public cListener {
+  protected:
+    // Estado de um nó: posição/velocidade da última atualização
+    struct NodeEntry {
+        cModule *node;
+        IMobility *mobility;
+        Coord position;
+        Coord velocity;
+        simtime_t updateTime;
+        int64_t cellKey;
+        size_t slotInCell;
+        bool moving;                                 // getMaxSpeed() != 0 (estacionários fora de updateOrder)
+        std::list<size_t>::iterator updateOrderIt;   // Posição em updateOrder
+    };
+
+    // === CONFIGURAÇÃO ===
+    double cellSize;             // Aresta da célula (>= maior alcance)
+    double maxSpeed;             // Velocidade máxima para margem de busca
+    simtime_t refreshInterval;   // Revalidação periódica dos baldes
+
+    // === ESTADO ===
+    std::vector<NodeEntry> nodes;                              // Armazenamento contíguo
+    std::unordered_map<int, size_t> nodeByMobilityId;          // Id do módulo de mobilidade -> entrada
+    std::unordered_map<int64_t, std::vector<size_t>> cells;    // Célula -> entradas
+    std::list<size_t> updateOrder;                             // Entradas móveis da mais antiga à mais recente atualização
+    cMessage *refreshTimer;
+    bool updating;
+
+  protected:
+    virtual void initialize(int stage) override;
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void handleMessage(cMessage *msg) override;
+    virtual void receiveSignal(cComponent *source, simsignal_t signalID, cObject *obj, cObject *details) override;
+
+    virtual void registerNodes();
+    virtual void refreshAll();
+    void updateEntry(size_t index);
+    void readState(NodeEntry& entry);
+    double getSearchMargin(simtime_t now) const;
+    void moveToCell(size_t index, int64_t cellKey);
+    int cellCoordinate(double value) const { return (int)std::floor(value / cellSize); }
+    int64_t getCellKey(const Coord& position) const;
+    Coord predictPosition(const NodeEntry& entry, simtime_t now) const;
+
+  public:
+    SpatialGrid() : refreshTimer(nullptr), updating(false) {}
+    virtual ~SpatialGrid();
+
+    // Registra/atualiza um nó a partir do seu módulo de mobilidade
+    virtual void updateNode(IMobility *mobility);
+
+    // Nós cuja posição atual está a até range metros de center (exclui 'exclude')
+    virtual void getNodesInRange(const Coord& center, double range, std::vector<cModule *>& result, const cModule *exclude = nullptr) const;
+    virtual int countNodesInRange(const Coord& center, double range, const cModule *exclude = nullptr) const;
+
+    int getNumNodes() const { return nodes.size(); }
+    double getCellSize() const { return cellSize; }
+
+    // Chave de 64 bits de uma célula (também usada pelo FanetNeighborCache)
+    static int64_t makeCellKey(int x, int y, int z);
+};
+
+#endif /* SPATIALGRID_H_ */
@@ -0,0 +1,52 @@
+/*
+ * SwarmMobility.cc
+ *
+ * Implementação da fachada de mobilidade do enxame
+ */
+
+#include "SwarmMobility.h"
+#include "SwarmMobilityController.h"
+#include "inet/common/ModuleAccess.h"
+
+using namespace omnetpp;
+using namespace inet;
+
+Define_Module(SwarmMobility);
+
+void SwarmMobility::initialize(int stage)
+{
+    MobilityBase::initialize(stage);
+
+    if (stage == INITSTAGE_LOCAL) {
+        maxSpeed = par("maxSpeed");
+        controller = getModuleFromPar<SwarmMobilityController>(par("controllerModule"), this);
+
+        // O passo é do controlador: um valor diferente aqui não teria efeito
+        simtime_t updateInterval = par("updateInterval");
+        simtime_t controllerInterval = controller->par("updateInterval");
+        if (updateInterval >= SIMTIME_ZERO && updateInterval != controllerInterval)
+            throw cRuntimeError("SwarmMobility: updateInterval=%s differs from the controller step %s; set %s.updateInterval instead",
+                                updateInterval.str().c_str(), controllerInterval.str().c_str(), controller->getFullPath().c_str());
+    }
+}
+
+void SwarmMobility::setInitialPosition()
+{
+    // Mesma inicialização do ArbitraryMobility
+    lastPosition = Coord(par("initialX"), par("initialY"), par("initialZ"));
+    double speed = uniform(par("minSpeed").doubleValue(), maxSpeed);
+    lastVelocity = Coord(speed, 0, 0);
+
+    // Limites de rebatida: área de contenção em X/Y, faixa de altitude em Z
+    Coord areaMin(constraintAreaMin.x, constraintAreaMin.y, par("minAltitude").doubleValue());
+    Coord areaMax(constraintAreaMax.x, constraintAreaMax.y, par("maxAltitude").doubleValue());
+    slot = controller->addNode(this, lastPosition, lastVelocity, areaMin, areaMax);
+
+    EV << "SwarmMobility: registered as slot " << slot << " at (" << lastPosition.x
+       << ", " << lastPosition.y << ", " << lastPosition.z << ")" << endl;
+}
+
+void SwarmMobility::handleSelfMessage(cMessage *message)
+{
+    throw cRuntimeError("SwarmMobility has no timers: unexpected message %s", message->getName());
+}
@@ -0,0 +1,52 @@
+/*
+ * SwarmMobility.h
+ *
+ * Fachada IMobility por nó para o SwarmMobilityController
+ *
+ * Não possui timer próprio: o controlador avança o enxame em lote e
+ * publica aqui a posição/velocidade de cada passo.
+ */
+
+#ifndef SWARMMOBILITY_H_
+#define SWARMMOBILITY_H_
+
+#include "inet/mobility/base/MobilityBase.h"
+
+using namespace omnetpp;
+using namespace inet;
+
+class SwarmMobilityController;
+
+class INET_API SwarmMobility : public MobilityBase {
+  protected:
+    SwarmMobilityController *controller;
+    int slot;               // Índice nos buffers do controlador
+    double maxSpeed;
+
+  protected:
+    virtual void initialize(int stage) override;
+    virtual void setInitialPosition() override;
+    virtual void handleSelfMessage(cMessage *message) override;
+
+  public:
+    SwarmMobility() : controller(nullptr), slot(-1), maxSpeed(0) {}
+
+    // Chamado pelo controlador após cada passo
+    void publish(const Coord& position, const Coord& velocity, bool emitSignal) {
+        lastPosition = position;
+        lastVelocity = velocity;
+        if (emitSignal)
+            emitMobilityStateChangedSignal();
+    }
+
+    // Posição/velocidade do último passo do enxame
+    virtual const Coord& getCurrentPosition() override { return lastPosition; }
+    virtual const Coord& getCurrentVelocity() override { return lastVelocity; }
+    virtual const Coord& getCurrentAcceleration() override { return Coord::ZERO; }
+    virtual const Quaternion& getCurrentAngularPosition() override { return lastOrientation; }
+    virtual const Quaternion& getCurrentAngularVelocity() override { return Quaternion::IDENTITY; }
+    virtual const Quaternion& getCurrentAngularAcceleration() override { return Quaternion::IDENTITY; }
+    virtual double getMaxSpeed() const override { return maxSpeed; }
+};
+
+#endif /* SWARMMOBILITY_H_ */
@@ -0,0 +1,154 @@
+/*
+ * SwarmMobilityController.cc
+ *
+ * Implementação do motor de mobilidade em lote do enxame
+ */
+
+#include "SwarmMobilityController.h"
+#include "SwarmMobility.h"
+#include "MobilityBounds.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace omnetpp;
+using namespace inet;
+
+Define_Module(SwarmMobilityController);
+
+// Integra um eixo de todos os nós e rebate nos limites (mesma BOUNDARY_MARGIN
+// do ArbitraryMobility). Sem desvios de fluxo: vetorizável pelo compilador.
+static void stepAxis(double *__restrict position, double *__restrict velocity,
+                     const double *__restrict min, const double *__restrict max,
+                     uint8_t *__restrict bounced, size_t n, double dt)
+{
+    for (size_t i = 0; i < n; i++) {
+        double p = position[i] + velocity[i] * dt;
+        double speed = std::fabs(velocity[i]);
+        bool low = p <= min[i];
+        bool high = p >= max[i];
+        position[i] = low ? min[i] + BOUNDARY_MARGIN : (high ? max[i] - BOUNDARY_MARGIN : p);
+        velocity[i] = low ? speed : (high ? -speed : velocity[i]);
+        bounced[i] |= (uint8_t)(low | high);
+    }
+}
+
+SwarmMobilityController::~SwarmMobilityController()
+{
+    cancelAndDelete(stepTimer);
+}
+
+void SwarmMobilityController::initialize(int stage)
+{
+    if (stage == INITSTAGE_LOCAL) {
+        updateInterval = par("updateInterval");
+        turnProbability = par("turnProbability");
+        emitSignals = par("emitSignals");
+        if (updateInterval <= 0)
+            throw cRuntimeError("updateInterval must be positive");
+
+        stepTimer = new cMessage("swarmStep");
+    }
+    else if (stage == INITSTAGE_LAST) {
+        // Fachadas se registram em INITSTAGE_SINGLE_MOBILITY; sem membros, nenhum evento
+        lastStep = simTime();
+        if (!members.empty())
+            scheduleAt(simTime() + updateInterval, stepTimer);
+
+        EV << "SwarmMobilityController: " << members.size() << " nodes, step "
+           << updateInterval << "s" << endl;
+    }
+}
+
+void SwarmMobilityController::handleMessage(cMessage *msg)
+{
+    if (msg == stepTimer) {
+        step();
+        publish();
+        scheduleAt(simTime() + updateInterval, stepTimer);
+    }
+    else
+        throw cRuntimeError("Unknown message: %s", msg->getName());
+}
+
+int SwarmMobilityController::addNode(SwarmMobility *mobility, const Coord& position, const Coord& velocity, const Coord& areaMin, const Coord& areaMax)
+{
+    Enter_Method("addNode");
+
+    x.push_back(position.x);
+    y.push_back(position.y);
+    z.push_back(position.z);
+    vx.push_back(velocity.x);
+    vy.push_back(velocity.y);
+    vz.push_back(velocity.z);
+    minX.push_back(areaMin.x);
+    maxX.push_back(areaMax.x);
+    minY.push_back(areaMin.y);
+    maxY.push_back(areaMax.y);
+    minZ.push_back(areaMin.z);
+    maxZ.push_back(areaMax.z);
+    bounced.push_back(0);
+    members.push_back(mobility);
+
+    return members.size() - 1;
+}
+
+// =============================================================================
+// PASSO DO ENXAME
+// =============================================================================
+
+void SwarmMobilityController::step()
+{
+    simtime_t now = simTime();
+    double dt = (now - lastStep).dbl();
+    size_t n = members.size();
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::fill(bounced.begin(), bounced.end(), 0);
+    stepAxis(x.data(), vx.data(), minX.data(), maxX.data(), bounced.data(), n, dt);
+    stepAxis(y.data(), vy.data(), minY.data(), maxY.data(), bounced.data(), n, dt);
+    stepAxis(z.data(), vz.data(), minZ.data(), maxZ.data(), bounced.data(), n, dt);
+    applyTurns();
+
+    kernelWallTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    lastStep = now;
+    numSteps++;
+}
+
+void SwarmMobilityController::applyTurns()
+{
+    // Curvas aleatórias apenas para quem não rebateu (como no ArbitraryMobility)
+    for (size_t i = 0; i < members.size(); i++) {
+        if (bounced[i]) {
+            numBounces++;
+            continue;
+        }
+        if (uniform(0, 1, 0) < turnProbability) {
+            double angle = uniform(0, 2 * M_PI, 0);
+            double speed = std::sqrt(vx[i] * vx[i] + vy[i] * vy[i]);
+            vx[i] = speed * std::cos(angle);
+            vy[i] = speed * std::sin(angle);
+            numTurns++;
+        }
+    }
+}
+
+void SwarmMobilityController::publish()
+{
+    for (size_t i = 0; i < members.size(); i++)
+        members[i]->publish(Coord(x[i], y[i], z[i]), Coord(vx[i], vy[i], vz[i]), emitSignals);
+}
+
+void SwarmMobilityController::finish()
+{
+    EV << "SwarmMobilityController: " << numSteps << " steps for " << members.size()
+       << " nodes, kernel wall time " << kernelWallTime << "s" << endl;
+
+    recordScalar("numNodes", members.size());
+    recordScalar("numSteps", numSteps);
+    recordScalar("numBounces", numBounces);
+    recordScalar("numTurns", numTurns);
+    recordScalar("kernelWallTime", kernelWallTime, "s");
+}
@@ -0,0 +1,70 @@
+/*
+ * SwarmMobilityController.h
+ *
+ * Motor de mobilidade em lote para o enxame de UAVs
+ *
+ * Mantém posição/velocidade de todos os nós em buffers estruturados por
+ * eixo (structure-of-arrays) e avança o enxame inteiro em um único evento
+ * por updateInterval. O resultado é publicado nas fachadas SwarmMobility
+ * de cada nó, lidas pela aplicação e pelo rádio como um IMobility comum.
+ */
+
+#ifndef SWARMMOBILITYCONTROLLER_H_
+#define SWARMMOBILITYCONTROLLER_H_
+
+#include "inet/common/INETDefs.h"
+#include "inet/common/geometry/common/Coord.h"
+#include <cstdint>
+#include <vector>
+
+using namespace omnetpp;
+using namespace inet;
+
+class SwarmMobility;
+
+class INET_API SwarmMobilityController : public cSimpleModule {
+  protected:
+    // === CONFIGURAÇÃO ===
+    simtime_t updateInterval;    // Passo de integração do enxame
+    double turnProbability;      // Chance de curva por passo (sem rebatida)
+    bool emitSignals;            // Emitir mobilityStateChanged em cada fachada
+
+    // === ESTADO (SoA: um vetor por eixo) ===
+    std::vector<double> x, y, z;
+    std::vector<double> vx, vy, vz;
+    std::vector<double> minX, maxX, minY, maxY, minZ, maxZ;
+    std::vector<uint8_t> bounced;
+    std::vector<SwarmMobility *> members;
+
+    cMessage *stepTimer;
+    simtime_t lastStep;
+
+    // === ESTATÍSTICAS ===
+    long numSteps;
+    long numBounces;
+    long numTurns;
+    double kernelWallTime;      // Tempo real gasto no kernel (s)
+
+  protected:
+    virtual void initialize(int stage) override;
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void handleMessage(cMessage *msg) override;
+    virtual void finish() override;
+
+    virtual void step();
+    virtual void applyTurns();
+    virtual void publish();
+
+  public:
+    SwarmMobilityController() : stepTimer(nullptr), numSteps(0), numBounces(0), numTurns(0), kernelWallTime(0) {}
+    virtual ~SwarmMobilityController();
+
+    // Registra um nó; retorna o índice (slot) nos buffers
+    virtual int addNode(SwarmMobility *mobility, const Coord& position, const Coord& velocity, const Coord& areaMin, const Coord& areaMax);
+
+    int getNumNodes() const { return members.size(); }
+    simtime_t getUpdateInterval() const { return updateInterval; }
+    bool getEmitSignals() const { return emitSignals; }
+};
+
+#endif /* SWARMMOBILITYCONTROLLER_H_ */
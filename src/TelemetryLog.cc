@@ -0,0 +1,104 @@
+/*
+ * TelemetryLog.cc
+ *
+ * Implementação do registro binário da telemetria recebida pela GCS
+ */
+
+#include "TelemetryLog.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+using namespace omnetpp;
+using namespace inet;
+
+// Serialização little-endian explícita, independente da ordem de bytes do host
+static uint8_t *putLE(uint8_t *out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++)
+        out[i] = (uint8_t)(value >> (8 * i));
+    return out + bytes;
+}
+
+static uint8_t *putDouble(uint8_t *out, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return putLE(out, bits, 8);
+}
+
+static uint8_t *putFloat(uint8_t *out, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return putLE(out, bits, 4);
+}
+
+void TelemetryLog::open(const std::string& path, size_t batchSize, int gcsNode) {
+    close();
+    file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        throw cRuntimeError("Cannot open telemetry log '%s'", path.c_str());
+
+    this->path = path;
+    this->batchSize = std::max(batchSize, (size_t)1);
+    batch.clear();
+    batch.reserve(this->batchSize * RECORD_SIZE);
+    records = 0;
+    flushes = 0;
+    wallTime = 0;
+    writeHeader(gcsNode);
+}
+
+void TelemetryLog::writeHeader(int gcsNode) {
+    // magic (8) | versão (4) | tamanho do registro (4) | nó da GCS (4) | reservado (12)
+    uint8_t header[32] = {0};
+    memcpy(header, "FANETTLM", 8);
+    uint8_t *out = putLE(header + 8, VERSION, 4);
+    out = putLE(out, RECORD_SIZE, 4);
+    putLE(out, (uint32_t)(int32_t)gcsNode, 4);
+    fwrite(header, sizeof(header), 1, file);
+}
+
+void TelemetryLog::append(const TelemetryLogRecord& record) {
+    auto start = std::chrono::steady_clock::now();
+    size_t offset = batch.size();
+    batch.resize(offset + RECORD_SIZE);
+    uint8_t *out = batch.data() + offset;
+    out = putDouble(out, record.arrivalTime);
+    out = putDouble(out, record.sampleTime);
+    out = putDouble(out, record.delay);
+    out = putDouble(out, record.positionX);
+    out = putDouble(out, record.positionY);
+    out = putDouble(out, record.positionZ);
+    out = putFloat(out, record.temperature);
+    out = putLE(out, record.sequence, 4);
+    out = putLE(out, record.sourceNode, 2);
+    out = putLE(out, record.hopCount, 1);
+    out = putLE(out, record.attempt, 1);
+    out = putLE(out, record.battery, 1);
+    out = putLE(out, record.flags, 1);
+    putLE(out, record.reserved, 2);
+    records++;
+    if (batch.size() >= batchSize * RECORD_SIZE)
+        flush();
+    wallTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void TelemetryLog::flush() {
+    if (file == nullptr || batch.empty())
+        return;
+
+    if (fwrite(batch.data(), 1, batch.size(), file) != batch.size())
+        throw cRuntimeError("Error writing telemetry log '%s'", path.c_str());
+    batch.clear();
+    flushes++;
+}
+
+void TelemetryLog::close() {
+    if (file == nullptr)
+        return;
+
+    auto start = std::chrono::steady_clock::now();
+    flush();
+    fclose(file);
+    file = nullptr;
+    wallTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
@@ -0,0 +1,84 @@
+/*
+ * TelemetryLog.h
+ *
+ * Registro binário da telemetria recebida pela GCS (ingestão para análise offline)
+ *
+ * - Cada chegada vira um registro de 64 bytes com campos tipados,
+ *   serializados campo a campo em little-endian (independe do host) e
+ *   acumulados em um lote em memória
+ * - O lote vai ao arquivo em uma única escrita quando enche e no finish()
+ * - Cabeçalho de 32 bytes: magic "FANETTLM", versão, tamanho do registro,
+ *   nó da GCS; lido por read-telemetry.py
+ */
+
+#ifndef TELEMETRYLOG_H_
+#define TELEMETRYLOG_H_
+
+#include "inet/common/INETDefs.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace omnetpp;
+using namespace inet;
+
+// Campos na ordem do arquivo: 8 bytes primeiro (sem preenchimento)
+struct TelemetryLogRecord {
+    double arrivalTime;         // Chegada à GCS (s)
+    double sampleTime;          // Leitura do sensor na origem (s)
+    double delay;               // Chegada - criação na origem (s)
+    double positionX;           // Posição do UAV na leitura (m)
+    double positionY;
+    double positionZ;
+    float temperature;          // °C
+    uint32_t sequence;          // Sequência da amostra na origem
+    uint16_t sourceNode;        // UAV de origem
+    uint8_t hopCount;           // Transmissões desde a origem
+    uint8_t attempt;            // 0 = original, > 0 = retransmissão
+    uint8_t battery;            // % (arredondado)
+    uint8_t flags;              // TELEMETRY_LOG_DUPLICATE
+    uint16_t reserved;
+};
+static_assert(sizeof(TelemetryLogRecord) == 64, "TelemetryLogRecord must be 64 bytes");
+
+enum TelemetryLogFlags {
+    TELEMETRY_LOG_DUPLICATE = 1     // Amostra já entregue antes (não conta na PDR)
+};
+
+class TelemetryLog {
+  private:
+    FILE *file;
+    std::string path;
+    std::vector<uint8_t> batch;     // Lote serializado, pré-alocado
+    size_t batchSize;
+    long records;                   // Registros escritos ou no lote
+    long flushes;
+    double wallTime;                // Tempo real em append/flush (s)
+
+    void writeHeader(int gcsNode);
+
+  public:
+    static const uint32_t VERSION = 1;
+    static const size_t RECORD_SIZE = 64;
+
+    TelemetryLog() : file(nullptr), batchSize(0), records(0), flushes(0), wallTime(0) {}
+    ~TelemetryLog() { close(); }
+
+    // Cria (sobrescreve) o arquivo; lança cRuntimeError se não puder abrir
+    void open(const std::string& path, size_t batchSize, int gcsNode);
+
+    // Lote cheio -> escrita única no arquivo
+    void append(const TelemetryLogRecord& record);
+    void flush();
+
+    // Escreve o lote pendente e fecha o arquivo
+    void close();
+
+    bool isOpen() const { return file != nullptr; }
+    const std::string& getPath() const { return path; }
+    long getRecords() const { return records; }
+    long getFlushes() const { return flushes; }
+    double getWallTime() const { return wallTime; }
+};
+
+#endif /* TELEMETRYLOG_H_ */
@@ -0,0 +1,93 @@
+/*
+ * TelemetryStore.cc
+ *
+ * Implementação do buffer store-and-forward de telemetria
+ */
+
+#include "TelemetryStore.h"
+
+using namespace omnetpp;
+using namespace inet;
+
+void TelemetryStore::initialize(size_t maxRecords, size_t maxBytes, EvictionPolicy policy) {
+    slots.assign(maxRecords, TelemetryRecord());
+    slotBytes.assign(maxRecords, 0);
+    this->maxBytes = maxBytes;
+    this->policy = policy;
+    head = 0;
+    count = 0;
+    bytes = 0;
+}
+
+bool TelemetryStore::push(const TelemetryRecord& record, int recordBytes, int& evicted) {
+    evicted = 0;
+    if (slots.empty() || (size_t)recordBytes > maxBytes || !canAdmit(record, recordBytes))
+        return false;
+
+    // Admissão já garantida: as vítimas saem na ordem de findVictim()
+    while (count == slots.size() || bytes + recordBytes > maxBytes) {
+        removeAt(findVictim());
+        evicted++;
+    }
+
+    size_t slot = slotAt(count);
+    slots[slot] = record;
+    slotBytes[slot] = recordBytes;
+    bytes += recordBytes;
+    count++;
+    return true;
+}
+
+bool TelemetryStore::canAdmit(const TelemetryRecord& record, size_t recordBytes) const {
+    // Simulação das remoções: apenas registros que findVictim() escolheria antes
+    // de recusar o novo (prioridade: saltos <= os do novo; mais antigo: todos)
+    size_t freedRecords = 0, freedBytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (policy == EVICT_DROP_OLDEST || slots[slotAt(i)].hopCount <= record.hopCount) {
+            freedRecords++;
+            freedBytes += slotBytes[slotAt(i)];
+        }
+    }
+    return count - freedRecords < slots.size() && bytes - freedBytes + recordBytes <= maxBytes;
+}
+
+bool TelemetryStore::pop(TelemetryRecord& record) {
+    if (count == 0)
+        return false;
+
+    record = slots[head];
+    removeAt(0);
+    return true;
+}
+
+size_t TelemetryStore::findVictim() const {
+    if (policy == EVICT_DROP_OLDEST)
+        return 0;
+
+    // Menos saltos investidos; em empate, o mais antigo (primeiro encontrado)
+    size_t victim = 0;
+    for (size_t i = 1; i < count; i++) {
+        if (slots[slotAt(i)].hopCount < slots[slotAt(victim)].hopCount)
+            victim = i;
+    }
+    return victim;
+}
+
+void TelemetryStore::removeAt(size_t position) {
+    bytes -= slotBytes[slotAt(position)];
+
+    if (position == 0) {
+        // Remoção do mais antigo: apenas avança a cabeça
+        slots[head].sensorData = nullptr;
+        head = (head + 1) % slots.size();
+    }
+    else {
+        // Remoção no meio: desloca os mais novos uma posição (anel limitado)
+        for (size_t i = position; i + 1 < count; i++) {
+            slots[slotAt(i)] = slots[slotAt(i + 1)];
+            slotBytes[slotAt(i)] = slotBytes[slotAt(i + 1)];
+        }
+        slots[slotAt(count - 1)].sensorData = nullptr;
+    }
+    count--;
+}
@@ -0,0 +1,77 @@
+/*
+ * TelemetryStore.h
+ *
+ * Buffer store-and-forward de telemetria da aplicação FANET
+ *
+ * - Anel com capacidade fixa alocado uma única vez (sem alocação por registro)
+ * - Limites de registros e de bytes
+ * - Descarte do mais antigo ou por prioridade (menos saltos investidos)
+ */
+
+#ifndef TELEMETRYSTORE_H_
+#define TELEMETRYSTORE_H_
+
+#include "inet/common/INETDefs.h"
+#include "FANETPacket_m.h"
+#include <vector>
+
+using namespace omnetpp;
+using namespace inet;
+
+/*
+ * Registro de telemetria retido por um nó (agregação ou store-and-forward)
+ */
+struct TelemetryRecord {
+    uint16_t sourceNode;                       // Nó de origem
+    uint32_t sequenceNumber;                   // Sequência da origem
+    uint8_t hopCount;                          // Transmissões já realizadas
+    uint8_t attempt;                           // Transmissão da amostra pela origem (0 = original)
+    simtime_t timestamp;                       // Criação na origem
+    simtime_t bufferedAt;                      // Entrada no buffer atual
+    Ptr<const FanetSensorData> sensorData;     // Leitura (chunk imutável compartilhado)
+
+    TelemetryRecord() : sourceNode(0), sequenceNumber(0), hopCount(0), attempt(0) {}
+};
+
+class TelemetryStore {
+  public:
+    enum EvictionPolicy {
+        EVICT_DROP_OLDEST,   // Descarta o registro mais antigo
+        EVICT_PRIORITY       // Descarta o de menor prioridade (menos saltos); empate -> mais antigo
+    };
+
+  private:
+    std::vector<TelemetryRecord> slots;   // Anel pré-alocado
+    std::vector<int> slotBytes;           // Tamanho de cada registro no anel
+    size_t head;                          // Registro mais antigo
+    size_t count;
+    size_t bytes;
+    size_t maxBytes;
+    EvictionPolicy policy;
+
+    size_t slotAt(size_t position) const { return (head + position) % slots.size(); }
+    size_t findVictim() const;
+    bool canAdmit(const TelemetryRecord& record, size_t recordBytes) const;
+    void removeAt(size_t position);
+
+  public:
+    TelemetryStore() : head(0), count(0), bytes(0), maxBytes(0), policy(EVICT_DROP_OLDEST) {}
+
+    // Aloca o anel (0 registros = desligado)
+    void initialize(size_t maxRecords, size_t maxBytes, EvictionPolicy policy);
+
+    // Armazena o registro, descartando outros se necessário (evicted: quantos
+    // registros já armazenados saíram). false: recusado sem descartar nenhum
+    bool push(const TelemetryRecord& record, int recordBytes, int& evicted);
+
+    // Retira o registro mais antigo; false se vazio
+    bool pop(TelemetryRecord& record);
+
+    bool isEnabled() const { return !slots.empty(); }
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    size_t getBytes() const { return bytes; }
+    size_t getCapacity() const { return slots.size(); }
+};
+
+#endif /* TELEMETRYSTORE_H_ */
@@ -0,0 +1,96 @@
+/*
+ * TxScheduler.cc
+ *
+ * Implementação do escalonador de transmissão por classes de tráfego
+ */
+
+#include "TxScheduler.h"
+
+using namespace omnetpp;
+using namespace inet;
+
+void TxScheduler::initialize(size_t capacity, bool weighted, const std::vector<int>& weights) {
+    clear();
+    queues.assign(NUM_TX_CLASSES, ClassQueue());
+    for (int i = 0; i < NUM_TX_CLASSES; i++) {
+        queues[i].weight = weighted ? weights.at(i) : 1;
+        queues[i].credit = queues[i].weight;
+        queues[i].enqueued = 0;
+        queues[i].sent = 0;
+        queues[i].dropped = 0;
+    }
+    this->capacity = capacity;
+    this->weighted = weighted;
+    current = 0;
+}
+
+bool TxScheduler::enqueue(TxClass txClass, Packet *packet, const L3Address& destAddr, simtime_t now) {
+    ClassQueue& queue = queues[txClass];
+    if (queue.entries.size() >= capacity) {
+        queue.dropped++;
+        return false;
+    }
+
+    Entry entry;
+    entry.packet = packet;
+    entry.destAddr = destAddr;
+    entry.enqueuedAt = now;
+    queue.entries.push_back(entry);
+    queue.enqueued++;
+    length++;
+    return true;
+}
+
+TxClass TxScheduler::dequeue(Entry& entry) {
+    ASSERT(length > 0);
+
+    int selected = -1;
+    if (!weighted) {
+        // Prioridade estrita: primeira classe não vazia
+        for (int i = 0; i < NUM_TX_CLASSES && selected < 0; i++) {
+            if (!queues[i].entries.empty())
+                selected = i;
+        }
+    }
+    else {
+        // Round-robin ponderado: classe vazia ou sem crédito cede a vez e
+        // recupera o peso para a próxima rodada (termina em <= NUM_TX_CLASSES + 1 passos)
+        while (selected < 0) {
+            ClassQueue& queue = queues[current];
+            if (!queue.entries.empty() && queue.credit > 0) {
+                queue.credit--;
+                selected = current;
+            }
+            else {
+                queue.credit = queue.weight;
+                current = (current + 1) % NUM_TX_CLASSES;
+            }
+        }
+    }
+
+    ClassQueue& queue = queues[selected];
+    entry = queue.entries.front();
+    queue.entries.pop_front();
+    queue.sent++;
+    length--;
+    return (TxClass)selected;
+}
+
+void TxScheduler::clear() {
+    for (auto& queue : queues) {
+        for (auto& entry : queue.entries)
+            delete entry.packet;
+        queue.entries.clear();
+    }
+    length = 0;
+}
+
+const char *TxScheduler::getClassName(TxClass txClass) {
+    switch (txClass) {
+        case TX_CONTROL: return "control";
+        case TX_RELAYED: return "relayed";
+        case TX_LOCAL: return "local";
+        case TX_BULK: return "bulk";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * TxScheduler.h
+ *
+ * Escalonador de transmissão por classes de tráfego da aplicação FANET
+ *
+ * - Uma fila FIFO limitada por classe (controle, telemetria encaminhada,
+ *   telemetria local, bulk); cheia -> o pacote novo é descartado (drop-tail)
+ * - Prioridade estrita (menor classe primeiro) ou round-robin ponderado:
+ *   a cada rodada a classe c envia até weights[c] pacotes
+ * - Contadores de enfileirados, enviados e descartados por classe
+ */
+
+#ifndef TXSCHEDULER_H_
+#define TXSCHEDULER_H_
+
+#include "inet/common/INETDefs.h"
+#include "inet/common/packet/Packet.h"
+#include "inet/networklayer/common/L3Address.h"
+#include <deque>
+#include <vector>
+
+using namespace omnetpp;
+using namespace inet;
+
+enum TxClass {
+    TX_CONTROL = 0,     // Beacons e respostas de descoberta
+    TX_RELAYED,         // Telemetria de outros UAVs (relay/agregação)
+    TX_LOCAL,           // Telemetria gerada pelo próprio nó
+    TX_BULK,            // Retransmissões (telemetria confiável)
+    NUM_TX_CLASSES
+};
+
+class TxScheduler {
+  public:
+    struct Entry {
+        Packet *packet;
+        L3Address destAddr;
+        simtime_t enqueuedAt;
+    };
+
+    struct ClassQueue {
+        std::deque<Entry> entries;
+        int weight;
+        int credit;                 // Envios restantes na rodada (ponderado)
+        long enqueued;
+        long sent;
+        long dropped;
+    };
+
+  private:
+    std::vector<ClassQueue> queues;
+    size_t capacity;                // Pacotes por classe
+    bool weighted;
+    int current;                    // Classe da vez (ponderado)
+    size_t length;                  // Pacotes em todas as filas
+
+  public:
+    TxScheduler() : capacity(0), weighted(false), current(0), length(0) {}
+    ~TxScheduler() { clear(); }
+
+    // weights: uma entrada >= 1 por classe (apenas no modo ponderado)
+    void initialize(size_t capacity, bool weighted, const std::vector<int>& weights);
+
+    // false: fila da classe cheia (pacote continua com quem chamou)
+    bool enqueue(TxClass txClass, Packet *packet, const L3Address& destAddr, simtime_t now);
+
+    // Próximo pacote segundo a política; retorna a classe de origem
+    TxClass dequeue(Entry& entry);
+
+    // Descarta (delete) todos os pacotes retidos
+    void clear();
+
+    bool isEmpty() const { return length == 0; }
+    size_t getLength() const { return length; }
+    const ClassQueue& getQueue(TxClass txClass) const { return queues[txClass]; }
+
+    static const char *getClassName(TxClass txClass);
+};
+
+#endif /* TXSCHEDULER_H_ */
@@ -0,0 +1,138 @@
+/*
+ * UnitDiskMedium.cc
+ *
+ * Implementação do meio de disco unitário da FANET
+ */
+
+#include "UnitDiskMedium.h"
+#include "UnitDiskUdp.h"
+#include "inet/common/ModuleAccess.h"
+#include "inet/networklayer/common/L3AddressTag_m.h"
+#include "inet/networklayer/contract/ipv4/Ipv4Address.h"
+
+using namespace omnetpp;
+using namespace inet;
+
+Define_Module(UnitDiskMedium);
+
+void UnitDiskMedium::initialize(int stage)
+{
+    if (stage == INITSTAGE_LOCAL) {
+        delay = par("delay");
+        propagationDelay = par("propagationDelay");
+        lossProbability = par("lossProbability");
+        if (lossProbability < 0 || lossProbability > 1)
+            throw cRuntimeError("lossProbability must be in [0, 1]");
+
+        spatialGrid = findModuleFromPar<SpatialGrid>(par("spatialGridModule"), this);
+    }
+    else if (stage == INITSTAGE_LAST) {
+        EV << "UnitDiskMedium: " << members.size() << " nodes"
+           << (spatialGrid != nullptr ? " (spatial grid)" : " (linear scan)") << endl;
+    }
+}
+
+void UnitDiskMedium::handleMessage(cMessage *msg)
+{
+    throw cRuntimeError("UnitDiskMedium does not receive messages: %s", msg->getName());
+}
+
+L3Address UnitDiskMedium::registerNode(UnitDiskUdp *udp)
+{
+    Enter_Method("registerNode");
+
+    // 10.0.0.1, 10.0.0.2, ... na ordem (determinística) de inicialização
+    L3Address address = Ipv4Address(Ipv4Address(10, 0, 0, 0).getInt() + members.size() + 1);
+    members.push_back(udp);
+    memberByAddress[address] = udp;
+    memberByNodeId[udp->getNode()->getId()] = udp;
+    return address;
+}
+
+// =============================================================================
+// TRANSMISSÃO
+// =============================================================================
+
+void UnitDiskMedium::transmit(UnitDiskUdp *sender, Packet *packet, const L3Address& destAddress)
+{
+    Enter_Method("transmit");
+    take(packet);
+
+    numTransmissions++;
+    Coord position = sender->getCurrentPosition();
+    double range = sender->getRange();
+
+    auto addressInd = packet->addTag<L3AddressInd>();
+    addressInd->setSrcAddress(sender->getAddress());
+    addressInd->setDestAddress(destAddress);
+
+    if (destAddress.isBroadcast()) {
+        // Candidatos da grade vêm com margem: distância real conferida no envio
+        collectReceivers(sender, position, range);
+        for (cModule *node : candidates) {
+            auto it = memberByNodeId.find(node->getId());
+            if (it == memberByNodeId.end())
+                continue;
+            double distance = position.distance(it->second->getCurrentPosition());
+            if (distance <= range)
+                deliver(sender, it->second, packet, distance);
+        }
+    }
+    else {
+        auto it = memberByAddress.find(destAddress);
+        if (it != memberByAddress.end() && it->second != sender) {
+            double distance = position.distance(it->second->getCurrentPosition());
+            if (distance <= range)
+                deliver(sender, it->second, packet, distance);
+            else
+                numOutOfRange++;
+        }
+        else
+            numOutOfRange++;
+    }
+
+    delete packet;
+}
+
+void UnitDiskMedium::collectReceivers(UnitDiskUdp *sender, const Coord& position, double range)
+{
+    candidates.clear();
+    if (spatialGrid != nullptr) {
+        spatialGrid->getNodesInRange(position, range, candidates, sender->getNode());
+        return;
+    }
+
+    // Sem índice espacial: varredura de todos os nós registrados
+    for (UnitDiskUdp *member : members) {
+        if (member != sender && position.distance(member->getCurrentPosition()) <= range)
+            candidates.push_back(member->getNode());
+    }
+}
+
+void UnitDiskMedium::deliver(UnitDiskUdp *sender, UnitDiskUdp *receiver, Packet *packet, double distance)
+{
+    if (lossProbability > 0 && uniform(0, 1) < lossProbability) {
+        numLost++;
+        return;
+    }
+
+    simtime_t arrivalDelay = delay;
+    if (propagationDelay)
+        arrivalDelay += distance / 299792458.0;  // Velocidade da luz (m/s)
+
+    // Cópia rasa: os chunks (imutáveis) são compartilhados entre os receptores
+    sendDirect(packet->dup(), arrivalDelay, 0, receiver->gate("radioIn"));
+    numDeliveries++;
+}
+
+void UnitDiskMedium::finish()
+{
+    EV << "UnitDiskMedium: " << numTransmissions << " transmissions, " << numDeliveries
+       << " deliveries, " << numLost << " lost" << endl;
+
+    recordScalar("numNodes", members.size());
+    recordScalar("numTransmissions", numTransmissions);
+    recordScalar("numDeliveries", numDeliveries);
+    recordScalar("numLost", numLost);
+    recordScalar("numOutOfRange", numOutOfRange);
+}
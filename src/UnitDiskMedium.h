@@ -0,0 +1,69 @@
+/*
+ * UnitDiskMedium.h
+ *
+ * Meio de disco unitário para execuções de grande escala da FANET
+ *
+ * Substitui a pilha 802.11/IPv4/UDP e o Ieee80211ScalarRadioMedium: um
+ * quadro FANET é entregue diretamente (sendDirect) ao UnitDiskUdp de
+ * todo nó dentro do alcance do transmissor, com atraso e perda
+ * configuráveis. Sem camada física, MAC ou colisões.
+ */
+
+#ifndef UNITDISKMEDIUM_H_
+#define UNITDISKMEDIUM_H_
+
+#include "inet/common/INETDefs.h"
+#include "inet/common/packet/Packet.h"
+#include "inet/networklayer/common/L3Address.h"
+#include "NeighborTable.h"
+#include "SpatialGrid.h"
+#include <unordered_map>
+#include <vector>
+
+using namespace omnetpp;
+using namespace inet;
+
+class UnitDiskUdp;
+
+class INET_API UnitDiskMedium : public cSimpleModule {
+  protected:
+    // === CONFIGURAÇÃO ===
+    simtime_t delay;              // Atraso fixo por quadro (acesso + transmissão)
+    bool propagationDelay;        // Somar distância / c ao atraso
+    double lossProbability;       // Perda independente por receptor
+    SpatialGrid *spatialGrid;     // Índice espacial (nullptr = varredura O(N))
+
+    // === NÓS REGISTRADOS ===
+    std::vector<UnitDiskUdp *> members;
+    std::unordered_map<L3Address, UnitDiskUdp *, L3AddressHash> memberByAddress;
+    std::unordered_map<int, UnitDiskUdp *> memberByNodeId;   // Id do módulo do nó -> interface
+    std::vector<cModule *> candidates;                       // Resultado reutilizado das consultas
+
+    // === ESTATÍSTICAS ===
+    long numTransmissions;
+    long numDeliveries;
+    long numLost;
+    long numOutOfRange;
+
+  protected:
+    virtual void initialize(int stage) override;
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void handleMessage(cMessage *msg) override;
+    virtual void finish() override;
+
+    virtual void deliver(UnitDiskUdp *sender, UnitDiskUdp *receiver, Packet *packet, double distance);
+    virtual void collectReceivers(UnitDiskUdp *sender, const Coord& position, double range);
+
+  public:
+    UnitDiskMedium() : spatialGrid(nullptr), numTransmissions(0), numDeliveries(0), numLost(0), numOutOfRange(0) {}
+
+    // Registra a interface de um nó; retorna o endereço IPv4 atribuído
+    virtual L3Address registerNode(UnitDiskUdp *udp);
+
+    // Entrega o quadro (broadcast ou unicast) aos nós no alcance; assume a posse do pacote
+    virtual void transmit(UnitDiskUdp *sender, Packet *packet, const L3Address& destAddress);
+
+    int getNumNodes() const { return members.size(); }
+};
+
+#endif /* UNITDISKMEDIUM_H_ */
@@ -0,0 +1,142 @@
+/*
+ * UnitDiskUdp.cc
+ *
+ * Implementação da interface UDP leve do modo disco unitário
+ */
+
+#include "UnitDiskUdp.h"
+#include "UnitDiskMedium.h"
+#include "inet/common/ModuleAccess.h"
+#include "inet/common/packet/Message.h"
+#include "inet/common/socket/SocketTag_m.h"
+#include "inet/networklayer/common/L3AddressTag_m.h"
+#include "inet/transportlayer/common/L4PortTag_m.h"
+#include "inet/transportlayer/contract/udp/UdpControlInfo_m.h"
+
+using namespace omnetpp;
+using namespace inet;
+
+Define_Module(UnitDiskUdp);
+
+void UnitDiskUdp::initialize(int stage)
+{
+    if (stage == INITSTAGE_LOCAL) {
+        range = par("range");
+        if (range <= 0)
+            throw cRuntimeError("range must be positive");
+
+        medium = getModuleFromPar<UnitDiskMedium>(par("mediumModule"), this);
+        mobility = check_and_cast<IMobility *>(getModuleByPath("^.mobility"));
+    }
+    else if (stage == INITSTAGE_TRANSPORT_LAYER) {
+        // Mesmo estágio do Udp do INET: pronto antes da camada de aplicação
+        address = medium->registerNode(this);
+
+        EV << "UnitDiskUdp: " << address << " range " << range << "m" << endl;
+    }
+}
+
+void UnitDiskUdp::handleMessage(cMessage *msg)
+{
+    if (msg->arrivedOn("radioIn"))
+        handleMediumPacket(check_and_cast<Packet *>(msg));
+    else if (msg->getKind() == UDP_C_DATA)
+        handleAppPacket(check_and_cast<Packet *>(msg));
+    else
+        handleCommand(msg);
+}
+
+// =============================================================================
+// COMANDOS DO SOCKET
+// =============================================================================
+
+void UnitDiskUdp::handleCommand(cMessage *msg)
+{
+    int socketId = check_and_cast<ITaggedObject *>(msg)->getTags().getTag<SocketReq>()->getSocketId();
+
+    switch (msg->getKind()) {
+        case UDP_C_BIND: {
+            auto command = check_and_cast<UdpBindCommand *>(msg->getControlInfo());
+            int port = command->getLocalPort();
+            if (socketByPort.count(port))
+                throw cRuntimeError("UnitDiskUdp: port %d already bound", port);
+            socketByPort[port] = socketId;
+            portBySocket[socketId] = port;
+            break;
+        }
+        case UDP_C_SETOPTION:
+            // Broadcast é sempre permitido; demais opções não se aplicam ao disco unitário
+            break;
+        case UDP_C_CLOSE: {
+            closeSocket(socketId);
+            auto indication = new Indication("closed", UDP_I_SOCKET_CLOSED);
+            indication->setControlInfo(new UdpSocketClosedIndication());
+            indication->addTag<SocketInd>()->setSocketId(socketId);
+            send(indication, "appOut");
+            break;
+        }
+        case UDP_C_DESTROY:
+            closeSocket(socketId);
+            break;
+        default:
+            throw cRuntimeError("UnitDiskUdp: unsupported socket command %d", msg->getKind());
+    }
+
+    delete msg;
+}
+
+void UnitDiskUdp::closeSocket(int socketId)
+{
+    auto it = portBySocket.find(socketId);
+    if (it == portBySocket.end())
+        return;
+    socketByPort.erase(it->second);
+    portBySocket.erase(it);
+}
+
+// =============================================================================
+// DADOS
+// =============================================================================
+
+void UnitDiskUdp::handleAppPacket(Packet *packet)
+{
+    int socketId = packet->getTag<SocketReq>()->getSocketId();
+    auto portIt = portBySocket.find(socketId);
+    if (portIt == portBySocket.end())
+        throw cRuntimeError("UnitDiskUdp: send on unbound socket %d", socketId);
+
+    L3Address destAddress = packet->getTag<L3AddressReq>()->getDestAddress();
+    int destPort = packet->getTag<L4PortReq>()->getDestPort();
+
+    // Requisições substituídas pelas indicações que o receptor verá
+    packet->clearTags();
+    auto portInd = packet->addTag<L4PortInd>();
+    portInd->setSrcPort(portIt->second);
+    portInd->setDestPort(destPort);
+
+    numSent++;
+    medium->transmit(this, packet, destAddress);
+}
+
+void UnitDiskUdp::handleMediumPacket(Packet *packet)
+{
+    auto socketIt = socketByPort.find(packet->getTag<L4PortInd>()->getDestPort());
+    if (socketIt == socketByPort.end()) {
+        EV << "UnitDiskUdp: no socket on port " << packet->getTag<L4PortInd>()->getDestPort() << ", dropping" << endl;
+        numUnreachablePort++;
+        delete packet;
+        return;
+    }
+
+    numReceived++;
+    packet->setKind(UDP_I_DATA);
+    packet->addTagIfAbsent<SocketInd>()->setSocketId(socketIt->second);
+    send(packet, "appOut");
+}
+
+void UnitDiskUdp::finish()
+{
+    recordScalar("framesSent", numSent);
+    recordScalar("framesReceived", numReceived);
+    recordScalar("unreachablePort", numUnreachablePort);
+}
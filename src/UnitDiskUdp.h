@@ -0,0 +1,63 @@
+/*
+ * UnitDiskUdp.h
+ *
+ * Interface UDP leve dos nós FANET em modo disco unitário
+ *
+ * Atende aos comandos do UdpSocket (bind, opções, close) e entrega os
+ * dados ao UnitDiskMedium em vez de uma pilha UDP/IPv4/802.11. Na recepção
+ * reproduz as indicações do Udp do INET (SocketInd, L3AddressInd,
+ * L4PortInd, UDP_I_DATA), então a aplicação não percebe a diferença.
+ */
+
+#ifndef UNITDISKUDP_H_
+#define UNITDISKUDP_H_
+
+#include "inet/common/INETDefs.h"
+#include "inet/common/packet/Packet.h"
+#include "inet/mobility/contract/IMobility.h"
+#include "inet/networklayer/common/L3Address.h"
+#include <map>
+
+using namespace omnetpp;
+using namespace inet;
+
+class UnitDiskMedium;
+
+class INET_API UnitDiskUdp : public cSimpleModule {
+  protected:
+    // === CONFIGURAÇÃO ===
+    double range;                 // Alcance do disco unitário (metros)
+    UnitDiskMedium *medium;
+    IMobility *mobility;
+    L3Address address;            // Atribuído pelo meio no registro
+
+    // === SOCKETS ===
+    std::map<int, int> socketByPort;   // Porta local -> id do socket
+    std::map<int, int> portBySocket;   // Id do socket -> porta local
+
+    // === ESTATÍSTICAS ===
+    long numSent;
+    long numReceived;
+    long numUnreachablePort;
+
+  protected:
+    virtual void initialize(int stage) override;
+    virtual int numInitStages() const override { return NUM_INIT_STAGES; }
+    virtual void handleMessage(cMessage *msg) override;
+    virtual void finish() override;
+
+    virtual void handleCommand(cMessage *msg);
+    virtual void handleAppPacket(Packet *packet);
+    virtual void handleMediumPacket(Packet *packet);
+    virtual void closeSocket(int socketId);
+
+  public:
+    UnitDiskUdp() : range(0), medium(nullptr), mobility(nullptr), numSent(0), numReceived(0), numUnreachablePort(0) {}
+
+    double getRange() const { return range; }
+    const L3Address& getAddress() const { return address; }
+    Coord getCurrentPosition() const { return mobility->getCurrentPosition(); }
+    cModule *getNode() const { return getParentModule(); }
+};
+
+#endif /* UNITDISKUDP_H_ */